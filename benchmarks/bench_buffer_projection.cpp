@@ -0,0 +1,117 @@
+// Area inflation of buffered polygons by latitude band: buffering in lon/lat
+// with an averaged degree scale (BufferProjection::Degrees) against
+// buffering in a local azimuthal equidistant projection.
+//
+// Inflation is the area the buffer adds over the area an exact buffer of
+// the same distance adds (Steiner's formula: P d + pi d^2), so 1.0 is exact.
+// Clearance is the smallest distance from the cell to the buffered ring over
+// the buffer distance; below 1 the buffer falls short somewhere.
+#include "h3_toolkit.hpp"
+#include <h3api.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Ring = std::vector<std::pair<double, double>>;
+
+constexpr double kEarthRadiusM = 6371007.180918475;
+
+LatLng to_latlng(const std::pair<double, double>& lonlat) {
+    return {degsToRads(lonlat.second), degsToRads(lonlat.first)};
+}
+
+/** Area of a closed (lon, lat) ring on the sphere, in m^2. */
+double spherical_area(const Ring& ring) {
+    double sum = 0;
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+        LatLng a = to_latlng(ring[i]);
+        LatLng b = to_latlng(ring[i + 1]);
+        sum += (b.lng - a.lng) * (2 + std::sin(a.lat) + std::sin(b.lat));
+    }
+    return std::abs(sum) * kEarthRadiusM * kEarthRadiusM / 2;
+}
+
+double perimeter(const Ring& ring) {
+    double total = 0;
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+        LatLng a = to_latlng(ring[i]);
+        LatLng b = to_latlng(ring[i + 1]);
+        total += greatCircleDistanceM(&a, &b);
+    }
+    return total;
+}
+
+/** Distance in meters from p to the great-circle segment a-b. */
+double distance_to_segment(const LatLng& p, const LatLng& a, const LatLng& b) {
+    double ab = greatCircleDistanceRads(&a, &b);
+    double ap = greatCircleDistanceRads(&a, &p);
+    double bp = greatCircleDistanceRads(&b, &p);
+    if (ab < 1e-15) {
+        return ap * kEarthRadiusM;
+    }
+    auto bearing = [](const LatLng& from, const LatLng& to) {
+        return std::atan2(std::sin(to.lng - from.lng) * std::cos(to.lat),
+                          std::cos(from.lat) * std::sin(to.lat) -
+                              std::sin(from.lat) * std::cos(to.lat) * std::cos(to.lng - from.lng));
+    };
+    double cross_track = std::asin(std::sin(ap) * std::sin(bearing(a, p) - bearing(a, b)));
+    double along_track = std::acos(std::max(-1.0, std::min(1.0, std::cos(ap) / std::cos(cross_track))));
+    if (std::cos(bearing(a, p) - bearing(a, b)) < 0 || along_track > ab) {
+        return std::min(ap, bp) * kEarthRadiusM;
+    }
+    return std::abs(cross_track) * kEarthRadiusM;
+}
+
+/** Smallest distance from the vertices of 'outer' to the edges of 'inner'. */
+double clearance(const Ring& inner, const Ring& outer) {
+    double best = 1e300;
+    for (const auto& v : outer) {
+        LatLng p = to_latlng(v);
+        for (size_t i = 0; i + 1 < inner.size(); ++i) {
+            best = std::min(best, distance_to_segment(p, to_latlng(inner[i]), to_latlng(inner[i + 1])));
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    using h3_toolkit::BufferProjection;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Buffer Projection: Area Inflation by Latitude" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    const int res = 7;
+    double edge_m;
+    getHexagonEdgeLengthAvgM(res + 4, &edge_m);
+    std::cout << "res " << res << " cells, buffer " << std::fixed << std::setprecision(1) << edge_m
+              << " m (res + 4 edge)" << std::endl;
+    std::cout << std::setw(6) << "lat" << std::setw(14) << "inflation deg" << std::setw(15) << "inflation aeqd"
+              << std::setw(15) << "clearance deg" << std::setw(16) << "clearance aeqd" << std::endl;
+    std::cout << std::setprecision(3);
+
+    for (int lat = 0; lat <= 85; lat += 5) {
+        LatLng g = {degsToRads(lat + 0.5), degsToRads(10.0)};
+        H3Index cell;
+        latLngToCell(&g, res, &cell);
+        LatLng center;
+        cellToLatLng(cell, &center);
+        Ring base = h3_toolkit::cell_boundary(cell).outer();
+        double area = spherical_area(base);
+        double band = perimeter(base) * edge_m + M_PI * edge_m * edge_m;
+
+        Ring degrees = h3_toolkit::get_buffered_h3_polygon(cell, edge_m, BufferProjection::Degrees).outer();
+        Ring local = h3_toolkit::get_buffered_h3_polygon(cell, edge_m, BufferProjection::LocalAzimuthalEquidistant).outer();
+        std::cout << std::setw(6) << std::setprecision(1) << radsToDegs(center.lat) << std::setprecision(3)
+                  << std::setw(14) << (spherical_area(degrees) - area) / band << std::setw(15)
+                  << (spherical_area(local) - area) / band << std::setw(15) << clearance(base, degrees) / edge_m
+                  << std::setw(16) << clearance(base, local) / edge_m << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Per-call latency of buffering convex rings: the analytic offset behind
+// get_buffered_h3_polygon and the convex-hull mode of
+// get_buffered_boundary_polygon, against bg::buffer on the same ring with
+// the same 32-point round joins. Also times get_buffered_h3_polygon end to
+// end, which adds the cell boundary and the polygon conversions.
+#include "h3_toolkit.hpp"
+#include "convex_offset.hpp"
+#include <h3api.h>
+#include <boost/geometry.hpp>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace bg = boost::geometry;
+
+namespace {
+
+typedef h3_toolkit::detail::OffsetPoint point_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+template <typename F>
+double time_us(int reps, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < reps; ++i) {
+        f(i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+polygon_type to_polygon(const std::vector<std::pair<double, double>>& ring) {
+    polygon_type poly;
+    for (const auto& p : ring) {
+        poly.outer().push_back(point_type(p.first, p.second));
+    }
+    bg::correct(poly);
+    return poly;
+}
+
+/** Offset vs bg::buffer on each polygon, buffered by a tenth of its size. */
+void compare(const std::vector<polygon_type>& polygons, double& offset_us, double& buffer_us) {
+    std::vector<double> distances;
+    for (const auto& poly : polygons) {
+        distances.push_back(0.1 * std::sqrt(std::abs(bg::area(poly))));
+    }
+    int n = static_cast<int>(polygons.size());
+    offset_us = time_us(n, [&](int i) {
+        h3_toolkit::detail::OffsetRing ring;
+        h3_toolkit::detail::convex_offset(polygons[i].outer(), distances[i], 32, ring);
+    });
+    buffer_us = time_us(n, [&](int i) {
+        multi_polygon_type buffered;
+        bg::buffer(polygons[i], buffered, bg::strategy::buffer::distance_symmetric<double>(distances[i]),
+                   bg::strategy::buffer::side_straight(), bg::strategy::buffer::join_round(32),
+                   bg::strategy::buffer::end_round(32), bg::strategy::buffer::point_circle(32));
+    });
+}
+
+} // namespace
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Convex Offset Benchmark (us per call)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    const int samples = 500;
+    std::cout << std::setw(5) << "res" << std::setw(12) << "hex offset" << std::setw(12) << "hex bg" << std::setw(9)
+              << "speedup" << std::setw(13) << "hull offset" << std::setw(10) << "hull bg" << std::setw(9)
+              << "speedup" << std::setw(16) << "buffered_h3" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int res = 0; res <= 15; ++res) {
+        std::vector<H3Index> cells;
+        std::vector<polygon_type> hexagons;
+        std::vector<polygon_type> hulls;
+        for (int i = 0; i < samples; ++i) {
+            LatLng g = {degsToRads(-60.0 + 120.0 * i / samples), degsToRads(-180.0 + 360.0 * i / samples)};
+            H3Index cell;
+            latLngToCell(&g, res, &cell);
+            cells.push_back(cell);
+            hexagons.push_back(to_polygon(h3_toolkit::cell_boundary(cell).outer()));
+            // Hull of the outline of the res + 3 boundary children, as in convex-hull mode
+            if (res <= 12 && i < samples / 10) {
+                polygon_type outline = to_polygon(h3_toolkit::cell_boundary_from_children(cell, res + 3).outer());
+                polygon_type hull;
+                bg::convex_hull(outline, hull);
+                hulls.push_back(hull);
+            }
+        }
+
+        double hex_offset, hex_buffer;
+        compare(hexagons, hex_offset, hex_buffer);
+        double public_us = time_us(samples, [&](int i) { h3_toolkit::get_buffered_h3_polygon(cells[i]); });
+        std::cout << std::setw(5) << res << std::setw(12) << hex_offset << std::setw(12) << hex_buffer << std::setw(8)
+                  << hex_buffer / hex_offset << "x";
+        if (!hulls.empty()) {
+            double hull_offset, hull_buffer;
+            compare(hulls, hull_offset, hull_buffer);
+            std::cout << std::setw(13) << hull_offset << std::setw(10) << hull_buffer << std::setw(8)
+                      << hull_buffer / hull_offset << "x";
+        } else {
+            std::cout << std::setw(13) << "-" << std::setw(10) << "-" << std::setw(9) << "-";
+        }
+        std::cout << std::setw(16) << public_us << std::endl;
+    }
+    return 0;
+}
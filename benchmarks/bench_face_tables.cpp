@@ -0,0 +1,208 @@
+// Per-level cost of ancestor face tracing: the legacy nested std::map lookup
+// tables versus the constexpr dense face-mask tables now used by the library,
+// and the size/throughput trade-off of the multi-digit composite tables.
+#include "h3_toolkit.hpp"
+#include "face_tables.hpp"
+#include <h3api.h>
+#include <iostream>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+const int NUM_CELLS = 20000;
+const int REPEATS = 10;
+
+// Legacy implementation, kept verbatim here as the "before" baseline.
+namespace legacy {
+
+static const std::map<int, std::map<int, std::map<int, int>>>& get_hex_mapping() {
+    static std::map<int, std::map<int, std::map<int, int>>> m;
+    if (m.empty()) {
+        m[0][1] = {{2, 3}, {3, 1}, {1, 1}};
+        m[0][2] = {{4, 6}, {2, 2}, {6, 2}};
+        m[0][3] = {{6, 2}, {2, 3}, {3, 3}};
+        m[0][4] = {{1, 5}, {4, 4}, {5, 4}};
+        m[0][5] = {{1, 5}, {3, 1}, {5, 5}};
+        m[0][6] = {{4, 6}, {5, 4}, {6, 6}};
+        m[1][1] = {{3, 3}, {1, 3}, {5, 1}};
+        m[1][2] = {{2, 6}, {6, 6}, {3, 2}};
+        m[1][3] = {{2, 2}, {1, 3}, {3, 2}};
+        m[1][4] = {{4, 5}, {5, 5}, {6, 4}};
+        m[1][5] = {{1, 1}, {4, 5}, {5, 1}};
+        m[1][6] = {{4, 4}, {2, 6}, {6, 4}};
+    }
+    return m;
+}
+
+static const std::map<int, std::map<int, std::map<int, int>>>& get_pent_mapping() {
+    static std::map<int, std::map<int, std::map<int, int>>> m;
+    if (m.empty()) {
+        m[0][1] = {{4, 5}, {2, 1}, {6, 1}};
+        m[0][2] = {{6, 1}, {3, 2}, {2, 2}};
+        m[0][3] = {{5, 2}, {4, 2}, {6, 4}};
+        m[0][4] = {{3, 2}, {5, 4}, {1, 2}};
+        m[0][5] = {{5, 3}, {6, 5}, {4, 5}};
+        m[1][1] = {{2, 5}, {6, 5}, {3, 1}};
+        m[1][2] = {{3, 1}, {2, 1}, {1, 2}};
+        m[1][3] = {{1, 4}, {4, 3}, {5, 3}};
+        m[1][4] = {{1, 2}, {5, 2}, {4, 4}};
+        m[1][5] = {{2, 5}, {4, 3}, {6, 3}};
+    }
+    return m;
+}
+
+std::set<int> trace_cell_to_ancestor_faces(H3Index h, const std::set<int>& input_faces, int res_parent) {
+    int h_res = getResolution(h);
+    std::set<int> current_faces = input_faces;
+    H3Index current_h = h;
+    for (int res = h_res; res > res_parent; --res) {
+        if (isPentagon(current_h)) {
+            return {};
+        }
+        int parity = res % 2;
+        H3Index parent;
+        cellToParent(current_h, res - 1, &parent);
+        long long child_pos = (current_h >> ((15 - res) * 3)) & 0x7;
+        if (child_pos == 0) {
+            return {};
+        }
+        const auto& mapping = isPentagon(parent) ? get_pent_mapping() : get_hex_mapping();
+        if (mapping.count(parity) && mapping.at(parity).count(child_pos)) {
+            const auto& face_map = mapping.at(parity).at(child_pos);
+            std::set<int> next_faces;
+            for (int f : current_faces) {
+                if (face_map.count(f)) {
+                    next_faces.insert(face_map.at(f));
+                }
+            }
+            if (next_faces.empty()) {
+                return {};
+            }
+            current_faces = next_faces;
+        } else {
+            return {};
+        }
+        current_h = parent;
+    }
+    return current_faces;
+}
+
+} // namespace legacy
+
+// Random res-15 cells that stay on a res-0 boundary face all the way up, so
+// every trace runs the full 15 levels.
+std::vector<H3Index> make_boundary_cells(int count) {
+    std::mt19937 rng(42);
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    std::set<int> all_faces = {1, 2, 3, 4, 5, 6};
+
+    std::vector<H3Index> cells;
+    while ((int)cells.size() < count) {
+        H3Index h = base_cells[rng() % 122];
+        if (isPentagon(h)) continue;
+        for (int res = 1; res <= 15; ++res) {
+            H3Index candidate = 0;
+            for (int attempt = 0; attempt < 32; ++attempt) {
+                int digit = 1 + rng() % 6;
+                H3Index child;
+                cellToCenterChild(h, res, &child);
+                child |= (H3Index)digit << ((15 - res) * 3);
+                if (!h3_toolkit::trace_cell_to_ancestor_faces(child, all_faces, 0).empty()) {
+                    candidate = child;
+                    break;
+                }
+            }
+            h = candidate;
+            if (!h) break;
+        }
+        if (h) cells.push_back(h);
+    }
+    return cells;
+}
+
+template <typename F>
+double time_per_level_ns(const std::vector<H3Index>& cells, F&& trace, size_t& checksum) {
+    std::set<int> all_faces = {1, 2, 3, 4, 5, 6};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < REPEATS; ++rep) {
+        for (H3Index h : cells) {
+            checksum += trace(h, all_faces, 0);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::nano> elapsed = end - start;
+    return elapsed.count() / (double(REPEATS) * cells.size() * 15);
+}
+
+// Traces every cell res 15 -> res 0 consuming Stride digits per lookup.
+template <int Stride>
+void report_stride(const std::vector<H3Index>& cells, size_t expected_checksum) {
+    using Table = h3_toolkit::detail::CompositeTransitionTable<Stride>;
+    auto table = std::make_unique<Table>();
+    *table = h3_toolkit::detail::make_composite_table<Stride>(h3_toolkit::detail::kHexUpward);
+
+    size_t checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < REPEATS; ++rep) {
+        for (H3Index h : cells) {
+            checksum += h3_toolkit::face_count(static_cast<h3_toolkit::FaceMask>(
+                h3_toolkit::detail::trace_mask_upward_strided(h, 15, 0, h3_toolkit::detail::kAllFacesMask, *table)));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::nano> elapsed = end - start;
+    double ns_per_trace = elapsed.count() / (double(REPEATS) * cells.size());
+
+    std::cout << "stride " << Stride << ": " << sizeof(table->next) / 1024.0 << " KiB, "
+              << 15 / Stride + 15 % Stride << " lookups, " << ns_per_trace << " ns/trace, "
+              << 1e3 / ns_per_trace << " M cells/sec";
+    if (Stride == h3_toolkit::detail::kTraceStride) std::cout << "  <- library default";
+    if (checksum != expected_checksum) std::cout << "  MISMATCH";
+    std::cout << std::endl;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Face table lookup benchmark (res 15 -> res 0)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    auto cells = make_boundary_cells(NUM_CELLS);
+    std::cout << "Cells: " << cells.size() << " x " << REPEATS << " repeats, 15 levels each" << std::endl;
+    std::cout << std::endl;
+
+    size_t legacy_sum = 0, table_sum = 0, mask_sum = 0;
+    double legacy_ns = time_per_level_ns(cells,
+        [](H3Index h, const std::set<int>& faces, int res) {
+            return legacy::trace_cell_to_ancestor_faces(h, faces, res).size();
+        }, legacy_sum);
+    double table_ns = time_per_level_ns(cells,
+        [](H3Index h, const std::set<int>& faces, int res) {
+            return h3_toolkit::trace_cell_to_ancestor_faces(h, faces, res).size();
+        }, table_sum);
+    double mask_ns = time_per_level_ns(cells,
+        [](H3Index h, const std::set<int>&, int res) {
+            return (size_t)h3_toolkit::face_count(
+                h3_toolkit::trace_cell_to_ancestor_faces(h, h3_toolkit::FaceMask::All, res));
+        }, mask_sum);
+
+    std::cout << "std::map tables:   " << legacy_ns << " ns/level" << std::endl;
+    std::cout << "constexpr tables:  " << table_ns << " ns/level (std::set API)" << std::endl;
+    std::cout << "constexpr tables:  " << mask_ns << " ns/level (FaceMask API)" << std::endl;
+    std::cout << "Speedup:           " << (legacy_ns / table_ns) << "x" << std::endl;
+    if (legacy_sum != table_sum || legacy_sum != mask_sum) {
+        std::cout << "MISMATCH: results differ between implementations" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Composite tables (res 15 -> res 0, one trace per cell):" << std::endl;
+    report_stride<1>(cells, mask_sum);
+    report_stride<2>(cells, mask_sum);
+    report_stride<3>(cells, mask_sum);
+    report_stride<4>(cells, mask_sum);
+    return 0;
+}
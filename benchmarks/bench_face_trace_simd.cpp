@@ -0,0 +1,92 @@
+// Batch ancestor face tracing throughput (res 15 -> res 0) for each SIMD
+// level the running CPU supports.
+#include "h3_toolkit.hpp"
+#include <h3api.h>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+
+const int NUM_CELLS = 1 << 20;
+const int REPEATS = 20;
+
+// Random res-15 cells that stay on a res-0 boundary face all the way up, so
+// every trace runs the full 15 levels.
+std::vector<H3Index> make_boundary_cells(int count) {
+    std::mt19937 rng(42);
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+
+    std::vector<H3Index> cells;
+    while ((int)cells.size() < count) {
+        H3Index h = base_cells[rng() % 122];
+        if (isPentagon(h)) continue;
+        for (int res = 1; res <= 15 && h; ++res) {
+            H3Index candidate = 0;
+            for (int attempt = 0; attempt < 32; ++attempt) {
+                H3Index child;
+                cellToCenterChild(h, res, &child);
+                child |= (H3Index)(1 + rng() % 6) << ((15 - res) * 3);
+                if (h3_toolkit::trace_cell_to_ancestor_faces(child, h3_toolkit::FaceMask::All, 0) !=
+                    h3_toolkit::FaceMask::None) {
+                    candidate = child;
+                    break;
+                }
+            }
+            h = candidate;
+        }
+        if (h) cells.push_back(h);
+    }
+    return cells;
+}
+
+const char* level_name(h3_toolkit::SimdLevel level) {
+    switch (level) {
+        case h3_toolkit::SimdLevel::Scalar: return "scalar";
+        case h3_toolkit::SimdLevel::AVX2: return "AVX2";
+        case h3_toolkit::SimdLevel::AVX512: return "AVX-512";
+    }
+    return "?";
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Batch face trace benchmark (res 15 -> res 0)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    auto cells = make_boundary_cells(NUM_CELLS);
+    std::vector<h3_toolkit::FaceMask> faces(cells.size()), reference(cells.size());
+    std::vector<H3Error> status(cells.size());
+    std::cout << "Cells: " << cells.size() << " x " << REPEATS << " repeats" << std::endl;
+    std::cout << "Detected: " << level_name(h3_toolkit::detected_simd_level()) << std::endl;
+    std::cout << "(SSE4 has no gather instruction; CPUs without AVX2 use the scalar kernel.)" << std::endl;
+    std::cout << std::endl;
+
+    double scalar_rate = 0;
+    int exit_code = 0;
+    for (auto level : {h3_toolkit::SimdLevel::Scalar, h3_toolkit::SimdLevel::AVX2, h3_toolkit::SimdLevel::AVX512}) {
+        if (h3_toolkit::set_simd_level(level) != level) {
+            std::cout << level_name(level) << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int rep = 0; rep < REPEATS; ++rep) {
+            h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), cells.size(), h3_toolkit::FaceMask::All, 0,
+                                                      faces.data(), status.data());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        double rate = double(REPEATS) * cells.size() / elapsed.count();
+
+        if (level == h3_toolkit::SimdLevel::Scalar) {
+            scalar_rate = rate;
+            reference = faces;
+        } else if (faces != reference) {
+            std::cout << "MISMATCH: " << level_name(level) << " differs from scalar" << std::endl;
+            exit_code = 1;
+        }
+        std::cout << level_name(level) << ": " << rate / 1e6 << " M cells/sec ("
+                  << rate / scalar_rate << "x scalar)" << std::endl;
+    }
+    return exit_code;
+}
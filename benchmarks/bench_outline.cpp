@@ -0,0 +1,50 @@
+// Outline construction time for a parent's boundary children across
+// parent/target resolution pairs: the exterior-edge trace behind
+// cell_boundary_from_children, h3lib's cellsToLinkedMultiPolygon and the
+// cascaded Boost.Geometry union.
+#include "h3_toolkit.hpp"
+#include <h3api.h>
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Outline Benchmark (ms)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+
+    const std::vector<std::pair<int, int>> pairs = {{5, 8}, {5, 9}, {5, 10}, {5, 11}, {6, 12}, {7, 13}};
+    std::cout << std::setw(8) << "parent" << std::setw(8) << "target" << std::setw(10) << "cells"
+              << std::setw(12) << "edge trace" << std::setw(10) << "h3lib" << std::setw(10) << "boost" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& pair : pairs) {
+        H3Index parent;
+        latLngToCell(&g, pair.first, &parent);
+        int64_t count = h3_toolkit::count_children_on_boundary_faces(parent, pair.second, h3_toolkit::FaceMask::All);
+
+        double traced = time_ms([&] { h3_toolkit::cell_boundary_from_children(parent, pair.second); });
+        double native = time_ms([&] {
+            h3_toolkit::cell_polygons_from_children(parent, pair.second, h3_toolkit::OutlineBackend::H3);
+        });
+        double boost = time_ms([&] {
+            h3_toolkit::cell_polygons_from_children(parent, pair.second, h3_toolkit::OutlineBackend::Boost);
+        });
+        std::cout << std::setw(8) << pair.first << std::setw(8) << pair.second << std::setw(10) << count
+                  << std::setw(12) << traced << std::setw(10) << native << std::setw(10) << boost << std::endl;
+    }
+    return 0;
+}
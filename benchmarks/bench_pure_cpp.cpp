@@ -1,8 +1,11 @@
 #include "h3_toolkit.hpp"
 #include <h3api.h>
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <set>
+#include <thread>
+#include <vector>
 
 const int TARGET_RES = 15;
 
@@ -31,6 +34,60 @@ int main() {
     std::cout << "Count: " << result.size() << std::endl;
     std::cout << "Time:  " << elapsed.count() << " seconds" << std::endl;
     std::cout << "Rate:  " << (result.size() / elapsed.count()) << " cells/sec" << std::endl;
-    
+
+    start = std::chrono::high_resolution_clock::now();
+    int64_t expected = h3_toolkit::count_children_on_boundary_faces(cell_res0, TARGET_RES, all_faces);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::micro> count_elapsed = end - start;
+    std::cout << "Closed-form count: " << expected << " in " << count_elapsed.count() << " us"
+              << (expected == (int64_t)result.size() ? "" : "  MISMATCH") << std::endl;
+
+    // Many parents at one depth: after the first, every hexagon parent is
+    // stamped from the cached suffix template instead of walked.
+    std::cout << std::endl;
+    const int PARENT_RES = 5, DEPTH = 6;
+    std::vector<H3Index> parents(7 * 7 * 7 * 7 * 7);
+    cellToChildren(base_cells[0], PARENT_RES, parents.data());
+    size_t repeated_total = 0, walked_total = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (H3Index parent : parents) {
+        repeated_total += h3_toolkit::children_on_boundary_faces(parent, PARENT_RES + DEPTH, h3_toolkit::FaceMask::All).size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> stamped = end - start;
+    start = std::chrono::high_resolution_clock::now();
+    for (H3Index parent : parents) {
+        h3_toolkit::for_each_child_on_boundary_faces(parent, PARENT_RES + DEPTH, h3_toolkit::FaceMask::All,
+                                                     [&](H3Index) { ++walked_total; });
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> walked = end - start;
+    std::cout << parents.size() << " parents at res " << PARENT_RES << ", depth " << DEPTH << ":" << std::endl;
+    std::cout << "  templates: " << (repeated_total / stamped.count()) << " cells/sec" << std::endl;
+    std::cout << "  tree walk: " << (walked_total / walked.count()) << " cells/sec"
+              << (walked_total == repeated_total ? "" : "  MISMATCH") << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Parallel scaling (work-stealing, automatic split depth):" << std::endl;
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back((int)t);
+    thread_counts.push_back((int)max_threads);
+    double single_thread_time = 0;
+    for (int threads : thread_counts) {
+        h3_toolkit::ParallelOptions options;
+        options.num_threads = threads;
+        start = std::chrono::high_resolution_clock::now();
+        auto parallel = h3_toolkit::children_on_boundary_faces_parallel(
+            cell_res0, TARGET_RES, h3_toolkit::FaceMask::All, options);
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = end - start;
+        if (threads == 1) single_thread_time = elapsed.count();
+        std::cout << "  " << threads << " threads: " << elapsed.count() << " s, "
+                  << (parallel.size() / elapsed.count()) << " cells/sec, "
+                  << (single_thread_time / elapsed.count()) << "x"
+                  << (parallel == result ? "" : "  MISMATCH") << std::endl;
+    }
+
     return 0;
 }
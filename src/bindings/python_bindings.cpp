@@ -1,4 +1,5 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include "h3_toolkit.hpp"
 #include <h3api.h>
@@ -59,6 +60,66 @@ std::vector<std::string> py_children_on_boundary_faces(
     return result;
 }
 
+// Helper: Hand a vector to numpy without copying; the array owns it
+template <typename T>
+py::array_t<T> to_numpy(std::vector<T>&& values, std::vector<py::ssize_t> shape) {
+    auto* owned = new std::vector<T>(std::move(values));
+    py::capsule owner(owned, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+    return py::array_t<T>(shape, owned->data(), owner);
+}
+
+// Helper: A read-only numpy view of a buffer owned by 'owner', which it keeps alive
+template <typename T>
+py::array_t<T> numpy_view(const std::vector<T>& values, std::vector<py::ssize_t> shape, py::handle owner) {
+    py::array_t<T> view(shape, values.data(), owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+// Helper: Parts as nested lists, the coordinates of a GeoJSON MultiPolygon
+py::list polygon_coordinates(const h3_toolkit::PolygonResult& polygon) {
+    py::list parts;
+    for (size_t k = 0; k < polygon.num_parts(); ++k) {
+        py::list rings;
+        for (uint32_t j = polygon.part_offsets[k]; j < polygon.part_offsets[k + 1]; ++j) {
+            py::list ring;
+            for (uint32_t i = polygon.ring_offsets[j]; i < polygon.ring_offsets[j + 1]; ++i) {
+                ring.append(py::make_tuple(polygon.coords[2 * i], polygon.coords[2 * i + 1]));
+            }
+            rings.append(ring);
+        }
+        parts.append(rings);
+    }
+    return parts;
+}
+
+// Helper: Run a batch function on a list of hex cells, returning its CSR arrays
+template <typename Batch>
+py::dict py_polygon_batch(const std::vector<std::string>& cell_strs, const Batch& batch_fn) {
+    std::vector<H3Index> cells;
+    cells.reserve(cell_strs.size());
+    for (const auto& s : cell_strs) {
+        cells.push_back(string_to_h3(s));
+    }
+    h3_toolkit::PolygonBatch batch;
+    {
+        py::gil_scoped_release release;
+        batch = batch_fn(cells.data(), cells.size());
+    }
+    py::ssize_t num_points = static_cast<py::ssize_t>(batch.coords.size() / 2);
+    py::ssize_t num_offsets = static_cast<py::ssize_t>(batch.polygon_offsets.size());
+    py::ssize_t num_parts = static_cast<py::ssize_t>(batch.part_offsets.size());
+    py::ssize_t num_rings = static_cast<py::ssize_t>(batch.ring_offsets.size());
+    py::ssize_t num_cells = static_cast<py::ssize_t>(batch.status.size());
+    py::dict result;
+    result["coords"] = to_numpy(std::move(batch.coords), {num_points, 2});
+    result["polygon_offsets"] = to_numpy(std::move(batch.polygon_offsets), {num_offsets});
+    result["part_offsets"] = to_numpy(std::move(batch.part_offsets), {num_parts});
+    result["ring_offsets"] = to_numpy(std::move(batch.ring_offsets), {num_rings});
+    result["status"] = to_numpy(std::move(batch.status), {num_cells});
+    return result;
+}
+
 PYBIND11_MODULE(_h3_toolkit_cpp, m) {
     m.doc() = "H3-Toolkit C++ bindings for Python";
     
@@ -84,56 +145,185 @@ PYBIND11_MODULE(_h3_toolkit_cpp, m) {
           py::arg("h"), py::arg("input_faces") = std::set<int>{1, 2, 3, 4, 5, 6},
           "Finds the coarsest ancestor where h still lies on specified faces.");
     
+    py::class_<h3_toolkit::PolygonResult>(m, "PolygonResult",
+                                          "Polygon parts and rings in one flat coordinate buffer.")
+        .def_property_readonly("coords",
+             [](py::object self) {
+                 const auto& polygon = self.cast<const h3_toolkit::PolygonResult&>();
+                 return numpy_view(polygon.coords, {static_cast<py::ssize_t>(polygon.num_points()), 2}, self);
+             },
+             "(N, 2) float64 array of lon, lat; a view, no copy.")
+        .def_property_readonly("ring_offsets",
+             [](py::object self) {
+                 const auto& polygon = self.cast<const h3_toolkit::PolygonResult&>();
+                 return numpy_view(polygon.ring_offsets, {static_cast<py::ssize_t>(polygon.ring_offsets.size())}, self);
+             },
+             "uint32 array: ring j is coords[ring_offsets[j]:ring_offsets[j + 1]].")
+        .def_property_readonly("part_offsets",
+             [](py::object self) {
+                 const auto& polygon = self.cast<const h3_toolkit::PolygonResult&>();
+                 return numpy_view(polygon.part_offsets, {static_cast<py::ssize_t>(polygon.part_offsets.size())}, self);
+             },
+             "uint32 array: part k is rings part_offsets[k] to part_offsets[k + 1].")
+        .def_property_readonly("num_points", &h3_toolkit::PolygonResult::num_points)
+        .def_property_readonly("num_rings", &h3_toolkit::PolygonResult::num_rings)
+        .def_property_readonly("num_parts", &h3_toolkit::PolygonResult::num_parts)
+        .def("coordinates", &polygon_coordinates,
+             "Returns the parts as nested lists of (lon, lat), the coordinates of a GeoJSON MultiPolygon.")
+        .def("__len__", &h3_toolkit::PolygonResult::num_parts);
+
     m.def("cell_boundary",
           [](const std::string& cell_str) {
-              H3Index cell = string_to_h3(cell_str);
-              auto coords = h3_toolkit::cell_boundary(cell);
-              py::list result;
-              for (const auto& p : coords) {
-                  result.append(py::make_tuple(p.first, p.second));
-              }
-              return result;
+              return h3_toolkit::cell_boundary(string_to_h3(cell_str));
           },
           py::arg("cell"),
-          "Returns cell boundary as list of (lon, lat) pairs.");
+          "Returns the cell boundary as a PolygonResult.");
     
     m.def("cell_boundary_from_children",
           [](const std::string& parent_str, int target_res) {
-              H3Index parent = string_to_h3(parent_str);
-              auto coords = h3_toolkit::cell_boundary_from_children(parent, target_res);
-              py::list result;
-              for (const auto& p : coords) {
-                  result.append(py::make_tuple(p.first, p.second));
-              }
-              return result;
+              return h3_toolkit::cell_boundary_from_children(string_to_h3(parent_str), target_res);
           },
           py::arg("parent"), py::arg("target_res"),
-          "Returns merged boundary polygon of all boundary children.");
+          "Returns the merged outline of all boundary children as a PolygonResult.");
     
+    py::enum_<h3_toolkit::BufferProjection>(m, "BufferProjection",
+                                            "Where get_buffered_*_polygon apply the buffer distance.")
+        .value("Degrees", h3_toolkit::BufferProjection::Degrees)
+        .value("LocalAzimuthalEquidistant", h3_toolkit::BufferProjection::LocalAzimuthalEquidistant);
+
+    m.def("max_descendant_overhang", &h3_toolkit::max_descendant_overhang,
+          py::arg("res"), py::arg("descendant_res"), py::arg("pentagon") = false,
+          "Meters by which descendants at descendant_res can reach outside their ancestor at res.");
+
     m.def("get_buffered_h3_polygon",
-          [](const std::string& cell_str, double buffer_meters) {
-              H3Index cell = string_to_h3(cell_str);
-              auto coords = h3_toolkit::get_buffered_h3_polygon(cell, buffer_meters);
-              py::list result;
-              for (const auto& p : coords) {
-                  result.append(py::make_tuple(p.first, p.second));
-              }
-              return result;
+          [](const std::string& cell_str, double buffer_meters, h3_toolkit::BufferProjection projection) {
+              return h3_toolkit::get_buffered_h3_polygon(string_to_h3(cell_str), buffer_meters, projection);
           },
           py::arg("cell"), py::arg("buffer_meters") = -1.0,
-          "Returns buffered polygon of a single cell.");
+          py::arg("projection") = h3_toolkit::BufferProjection::Degrees,
+          "Returns the buffered polygon of a single cell as a PolygonResult.");
     
     m.def("get_buffered_boundary_polygon", 
-          [](const std::string& cell_str, int intermediate_res, double buffer_meters, bool use_convex_hull) {
+          [](const std::string& cell_str, int intermediate_res, double buffer_meters, bool use_convex_hull,
+             h3_toolkit::BufferProjection projection) {
+              return h3_toolkit::get_buffered_boundary_polygon(string_to_h3(cell_str), intermediate_res,
+                                                               buffer_meters, use_convex_hull, projection);
+          },
+          py::arg("cell"), py::arg("intermediate_res") = 10, py::arg("buffer_meters") = -1.0, py::arg("use_convex_hull") = true,
+          py::arg("projection") = h3_toolkit::BufferProjection::Degrees,
+          "Returns a buffered PolygonResult. use_convex_hull=True is fast, use_convex_hull=False is accurate.");
+
+    m.def("get_containment_polygon",
+          [](const std::string& cell_str, size_t max_vertices, double max_inflation, double buffer_meters,
+             int min_intermediate_res, int max_intermediate_res) {
               H3Index cell = string_to_h3(cell_str);
-              auto coords = h3_toolkit::get_buffered_boundary_polygon(cell, intermediate_res, buffer_meters, use_convex_hull);
-              // Return as list of [lon, lat] pairs
-              py::list result;
-              for (const auto& p : coords) {
-                  result.append(py::make_tuple(p.first, p.second));
-              }
+              h3_toolkit::ContainmentBudget budget;
+              budget.max_vertices = max_vertices;
+              budget.max_inflation = max_inflation;
+              budget.buffer_meters = buffer_meters;
+              budget.min_intermediate_res = min_intermediate_res;
+              budget.max_intermediate_res = max_intermediate_res;
+              h3_toolkit::ContainmentPolygon containment = h3_toolkit::get_containment_polygon(cell, budget);
+              py::dict result;
+              result["polygon"] = py::cast(std::move(containment.polygon));
+              result["vertex_count"] = containment.vertex_count;
+              result["inflation"] = containment.inflation;
+              result["intermediate_res"] = containment.intermediate_res;
+              result["arc_segments"] = containment.arc_segments;
+              result["buffer_meters"] = containment.buffer_meters;
+              result["within_budget"] = containment.within_budget;
               return result;
           },
-          py::arg("cell"), py::arg("intermediate_res") = 10, py::arg("buffer_meters") = -1.0, py::arg("use_convex_hull") = true,
-          "Returns a buffered polygon. use_convex_hull=True is fast, use_convex_hull=False is accurate.");
+          py::arg("cell"), py::arg("max_vertices") = 32, py::arg("max_inflation") = 1.25,
+          py::arg("buffer_meters") = -1.0, py::arg("min_intermediate_res") = -1, py::arg("max_intermediate_res") = -1,
+          "Returns a convex polygon containing the cell's res 15 descendants in at most max_vertices vertices.");
+
+    m.def("cell_boundaries",
+          [](const std::vector<std::string>& cells, int num_threads) {
+              h3_toolkit::ParallelOptions options;
+              options.num_threads = num_threads;
+              return py_polygon_batch(cells, [&](const H3Index* c, size_t n) {
+                  return h3_toolkit::cell_boundaries(c, n, options);
+              });
+          },
+          py::arg("cells"), py::arg("num_threads") = 0,
+          "Batch cell_boundary. Returns a dict of numpy arrays: coords (N x 2), polygon_offsets, "
+          "part_offsets, ring_offsets and status (H3Error per cell).");
+
+    m.def("cell_boundaries_from_children",
+          [](const std::vector<std::string>& cells, int target_res, int num_threads) {
+              h3_toolkit::ParallelOptions options;
+              options.num_threads = num_threads;
+              return py_polygon_batch(cells, [&](const H3Index* c, size_t n) {
+                  return h3_toolkit::cell_boundaries_from_children(c, n, target_res, options);
+              });
+          },
+          py::arg("cells"), py::arg("target_res"), py::arg("num_threads") = 0,
+          "Batch cell_boundary_from_children, in the form of cell_boundaries.");
+
+    m.def("get_buffered_h3_polygons",
+          [](const std::vector<std::string>& cells, double buffer_meters, h3_toolkit::BufferProjection projection,
+             int num_threads) {
+              h3_toolkit::ParallelOptions options;
+              options.num_threads = num_threads;
+              return py_polygon_batch(cells, [&](const H3Index* c, size_t n) {
+                  return h3_toolkit::get_buffered_h3_polygons(c, n, buffer_meters, projection, options);
+              });
+          },
+          py::arg("cells"), py::arg("buffer_meters") = -1.0,
+          py::arg("projection") = h3_toolkit::BufferProjection::Degrees, py::arg("num_threads") = 0,
+          "Batch get_buffered_h3_polygon, in the form of cell_boundaries.");
+
+    m.def("get_buffered_boundary_polygons",
+          [](const std::vector<std::string>& cells, int intermediate_res, double buffer_meters, bool use_convex_hull,
+             h3_toolkit::BufferProjection projection, int num_threads) {
+              h3_toolkit::ParallelOptions options;
+              options.num_threads = num_threads;
+              return py_polygon_batch(cells, [&](const H3Index* c, size_t n) {
+                  return h3_toolkit::get_buffered_boundary_polygons(c, n, intermediate_res, buffer_meters,
+                                                                    use_convex_hull, projection, options);
+              });
+          },
+          py::arg("cells"), py::arg("intermediate_res") = 10, py::arg("buffer_meters") = -1.0,
+          py::arg("use_convex_hull") = true, py::arg("projection") = h3_toolkit::BufferProjection::Degrees,
+          py::arg("num_threads") = 0,
+          "Batch get_buffered_boundary_polygon, in the form of cell_boundaries.");
+
+    m.def("set_polygon_cache_capacity", &h3_toolkit::set_polygon_cache_capacity,
+          py::arg("bytes"),
+          "Sets the byte budget of the LRU cache behind the polygon functions (0 disables it, the default).");
+
+    m.def("clear_polygon_cache", &h3_toolkit::clear_polygon_cache,
+          "Drops every cached polygon and resets the cache counters.");
+
+    m.def("polygon_cache_stats",
+          []() {
+              h3_toolkit::PolygonCacheStats stats = h3_toolkit::polygon_cache_stats();
+              py::dict result;
+              result["hits"] = stats.hits;
+              result["misses"] = stats.misses;
+              result["evictions"] = stats.evictions;
+              result["entries"] = stats.entries;
+              result["bytes"] = stats.bytes;
+              result["capacity_bytes"] = stats.capacity_bytes;
+              return result;
+          },
+          "Returns the polygon cache counters as a dict.");
+
+    py::class_<h3_toolkit::PolygonStore>(m, "PolygonStore",
+                                         "Memory-mapped polygon store written by the build_polygon_store tool.")
+        .def(py::init<const std::string&>(), py::arg("path"))
+        .def("polygon",
+             [](const h3_toolkit::PolygonStore& store, const std::string& cell_str) {
+                 return store.polygon(string_to_h3(cell_str));
+             },
+             py::arg("cell"),
+             "Returns the stored polygon of a cell, computing it live if the cell is not stored.")
+        .def("__contains__",
+             [](const h3_toolkit::PolygonStore& store, const std::string& cell_str) {
+                 return static_cast<bool>(store.find(string_to_h3(cell_str)));
+             })
+        .def("__len__", &h3_toolkit::PolygonStore::size)
+        .def_property_readonly("cell_res", [](const h3_toolkit::PolygonStore& store) { return store.spec().cell_res; })
+        .def_property_readonly("target_res", [](const h3_toolkit::PolygonStore& store) { return store.spec().target_res; });
 }
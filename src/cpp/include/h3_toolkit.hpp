@@ -1,11 +1,65 @@
 #pragma once
 
 #include <h3api.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace h3_toolkit {
 
+/**
+ * Set of cell faces stored as a 6-bit mask: bit (f - 1) is set when face f
+ * (1-6) is present.
+ *
+ * Allocation-free alternative to std::set<int>; union and intersection are
+ * the bitwise operators below.
+ */
+enum class FaceMask : uint8_t {
+    None = 0x00,
+    All = 0x3F
+};
+
+constexpr FaceMask operator|(FaceMask a, FaceMask b) {
+    return static_cast<FaceMask>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+constexpr FaceMask operator&(FaceMask a, FaceMask b) {
+    return static_cast<FaceMask>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+}
+constexpr FaceMask operator^(FaceMask a, FaceMask b) {
+    return static_cast<FaceMask>(static_cast<uint8_t>(a) ^ static_cast<uint8_t>(b));
+}
+/** Complement within the six valid faces. */
+constexpr FaceMask operator~(FaceMask a) {
+    return static_cast<FaceMask>(~static_cast<uint8_t>(a) & static_cast<uint8_t>(FaceMask::All));
+}
+inline FaceMask& operator|=(FaceMask& a, FaceMask b) { return a = a | b; }
+inline FaceMask& operator&=(FaceMask& a, FaceMask b) { return a = a & b; }
+
+/** Mask containing only `face`, or FaceMask::None if face is not in 1-6. */
+constexpr FaceMask face_bit(int face) {
+    return (face >= 1 && face <= 6) ? static_cast<FaceMask>(1 << (face - 1)) : FaceMask::None;
+}
+
+constexpr bool has_face(FaceMask mask, int face) {
+    return (mask & face_bit(face)) != FaceMask::None;
+}
+
+/** Number of faces in the mask. */
+int face_count(FaceMask mask);
+
+/** Converts a face set to a mask; values outside 1-6 are ignored. */
+FaceMask to_face_mask(const std::set<int>& faces);
+
+/** Converts a mask back to a face set. */
+std::set<int> to_face_set(FaceMask mask);
+
 /**
  * Traces which of the given input_faces the target H3 cell lies on for an ancestor
  * cell at a coarser resolution.
@@ -17,11 +71,75 @@ namespace h3_toolkit {
  */
 std::set<int> trace_cell_to_ancestor_faces(H3Index h, const std::set<int>& input_faces, int res_parent);
 
+/**
+ * FaceMask overload of trace_cell_to_ancestor_faces. Performs no allocation.
+ */
+FaceMask trace_cell_to_ancestor_faces(H3Index h, FaceMask input_faces, int res_parent);
+
 /**
  * Convenience overload that defaults to parent resolution (res - 1).
  */
 std::set<int> trace_cell_to_parent_faces(H3Index h, const std::set<int>& input_faces);
 
+/**
+ * FaceMask overload of trace_cell_to_parent_faces.
+ */
+FaceMask trace_cell_to_parent_faces(H3Index h, FaceMask input_faces);
+
+/**
+ * Batch form of trace_cell_to_ancestor_faces over a contiguous array of cells,
+ * sharing one input face mask and ancestor resolution.
+ *
+ * Never throws and performs no allocation. Each element gets a status code in
+ * the parallel out_status array (which may be null):
+ * - E_SUCCESS: out_faces[i] holds the traced faces (possibly FaceMask::None)
+ * - E_CELL_INVALID: cells[i] does not carry an H3 cell header
+ * - E_RES_DOMAIN: res_parent is not in [0, resolution of cells[i])
+ * Failed elements get FaceMask::None.
+ *
+ * Validation is a header check (mode, base cell, resolution), not a full
+ * isValidCell.
+ *
+ * @param cells Input cells.
+ * @param count Number of cells.
+ * @param input_faces Faces to trace, shared by all cells.
+ * @param res_parent Ancestor resolution, shared by all cells.
+ * @param out_faces Output array of count face masks.
+ * @param out_status Optional output array of count status codes.
+ */
+void trace_cells_to_ancestor_faces(const H3Index* cells, size_t count, FaceMask input_faces,
+                                   int res_parent, FaceMask* out_faces, H3Error* out_status) noexcept;
+
+/**
+ * Batch form with a per-element input face mask and ancestor resolution.
+ */
+void trace_cells_to_ancestor_faces(const H3Index* cells, size_t count, const FaceMask* input_faces,
+                                   const int* res_parents, FaceMask* out_faces, H3Error* out_status) noexcept;
+
+/**
+ * Instruction set used by the batch tracers. The best level supported by the
+ * running CPU is picked on first use; every level produces identical results.
+ */
+enum class SimdLevel {
+    Scalar,
+    AVX2,    // 4 cells per step, gather-based table lookups
+    AVX512,  // 8 cells per step (AVX-512F)
+};
+
+/** Highest SimdLevel supported by this CPU and build. */
+SimdLevel detected_simd_level() noexcept;
+
+/** SimdLevel currently used by the batch tracers. */
+SimdLevel active_simd_level() noexcept;
+
+/**
+ * Forces the batch tracers onto a given SimdLevel (clamped to what the CPU
+ * supports). Intended for benchmarks and tests.
+ *
+ * @return The level actually selected.
+ */
+SimdLevel set_simd_level(SimdLevel level) noexcept;
+
 /**
  * Returns all children of 'parent' at 'target_res' that lie on the parent's
  * specified boundary faces.
@@ -33,6 +151,269 @@ std::set<int> trace_cell_to_parent_faces(H3Index h, const std::set<int>& input_f
  */
 std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res, const std::set<int>& input_faces = {1,2,3,4,5,6});
 
+/**
+ * FaceMask overload of children_on_boundary_faces.
+ */
+std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces);
+
+/**
+ * The k-th (0-based) boundary child of 'parent' at 'target_res', in
+ * children_on_boundary_faces order, without enumerating the children before
+ * it. O(target_res - resolution of parent).
+ *
+ * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+ * @throws std::out_of_range if k is not in [0, count_children_on_boundary_faces).
+ */
+H3Index boundary_child_at(H3Index parent, int target_res, FaceMask input_faces, int64_t k);
+
+/**
+ * Inverse of boundary_child_at: the position of 'child' in the boundary
+ * child sequence of 'parent' at the child's resolution.
+ *
+ * @throws std::invalid_argument if child is not a descendant of parent lying
+ *         on the given boundary faces.
+ */
+int64_t boundary_child_rank(H3Index parent, H3Index child, FaceMask input_faces);
+
+/**
+ * The boundary children with ranks in [begin_rank, end_rank), e.g. one shard
+ * of a larger enumeration. Seeks straight to begin_rank.
+ *
+ * @throws std::out_of_range unless 0 <= begin_rank <= end_rank <= count.
+ */
+std::vector<H3Index> boundary_children_in_range(H3Index parent, int target_res, FaceMask input_faces,
+                                                int64_t begin_rank, int64_t end_rank);
+
+/** Threading options for the parallel entry points. */
+struct ParallelOptions {
+    /** Threads to use, caller included; 0 means all hardware threads. */
+    int num_threads = 0;
+    /**
+     * Levels below the parent at which the child tree is cut into tasks; 0
+     * picks the shallowest level giving enough tasks to balance the threads.
+     */
+    int split_depth = 0;
+};
+
+/**
+ * Parallel children_on_boundary_faces. The child tree is cut into subtrees
+ * 'split_depth' levels below the parent, which a work-stealing pool
+ * enumerates into pre-sized slices of the output (sized with
+ * count_children_on_boundary_faces), so the result is identical, order
+ * included, to the serial version.
+ *
+ * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+ */
+std::vector<H3Index> children_on_boundary_faces_parallel(H3Index parent, int target_res,
+                                                         FaceMask input_faces = FaceMask::All,
+                                                         const ParallelOptions& options = {});
+
+/** A stretch of a perimeter walk lying on one parent face: cells[begin, end). */
+struct PerimeterFaceRun {
+    int face;
+    int64_t begin;
+    int64_t end;
+};
+
+/** Boundary children in perimeter order; see children_on_boundary_faces_perimeter. */
+struct PerimeterChildren {
+    std::vector<H3Index> cells;
+    /** Each cell's own faces that lie on the parent's input faces, as in BoundaryChild. */
+    std::vector<FaceMask> faces;
+    /**
+     * One run per requested face, in walk order. Runs of adjacent faces
+     * overlap by the corner cell they share.
+     */
+    std::vector<PerimeterFaceRun> face_runs;
+    /** True when all six faces were requested and the walk returns to cells[0]. */
+    bool closed = false;
+};
+
+/**
+ * The same children as children_on_boundary_faces, ordered as a
+ * counter-clockwise walk along the parent's edge: consecutive cells are
+ * neighbors, and the parent faces come in the cyclic order 4, 6, 2, 3, 1, 5.
+ *
+ * With all faces requested the walk is closed and starts at the corner cell
+ * where face 5 meets face 4; the last run then also ends on cells[0].
+ * Otherwise it starts at the first requested face, counting from face 4,
+ * whose predecessor is not requested, and each run is a plain slice. A
+ * pentagon parent's walk steps over its missing digit-1 sector.
+ *
+ * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+ */
+PerimeterChildren children_on_boundary_faces_perimeter(H3Index parent, int target_res,
+                                                      FaceMask input_faces = FaceMask::All);
+
+/**
+ * Number of children of 'parent' at 'target_res' that lie on the parent's
+ * specified boundary faces, i.e. children_on_boundary_faces(...).size(),
+ * computed from precomputed transfer-matrix powers without enumerating.
+ *
+ * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+ */
+int64_t count_children_on_boundary_faces(H3Index parent, int target_res, const std::set<int>& input_faces = {1,2,3,4,5,6});
+
+/**
+ * FaceMask overload of count_children_on_boundary_faces.
+ */
+int64_t count_children_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces);
+
+/**
+ * Resumable depth-first walk over the boundary children of a cell, yielding
+ * them one at a time in the same order as children_on_boundary_faces. Uses a
+ * fixed amount of memory (under 1 KiB) regardless of how many children there
+ * are.
+ */
+class BoundaryChildCursor {
+public:
+    /**
+     * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+     */
+    BoundaryChildCursor(H3Index parent, int target_res, FaceMask input_faces);
+
+    /**
+     * Starts the walk at the child of rank start_rank (see boundary_child_rank)
+     * in O(target_res - resolution of parent), without visiting earlier ones.
+     *
+     * @throws std::out_of_range if start_rank is not in [0, count].
+     */
+    BoundaryChildCursor(H3Index parent, int target_res, FaceMask input_faces, int64_t start_rank);
+
+    /**
+     * Advances to the next boundary child.
+     * @param child Receives the child cell.
+     * @param faces Receives the child's own faces that lie on the parent's
+     *              input faces (trace_cell_to_ancestor_faces maps them back).
+     * @return false once the sequence is exhausted.
+     */
+    bool next(H3Index& child, FaceMask& faces) {
+        if (pos_ == size_ && !refill()) {
+            return false;
+        }
+        child = buffer_[pos_];
+        faces = buffer_faces_[pos_];
+        ++pos_;
+        return true;
+    }
+
+private:
+    // The walk runs out of line in batches of up to kBufferSize children so
+    // that the per-child cost of next() is an inline buffer read.
+    static constexpr int kBufferSize = 64;
+
+    bool refill();
+
+    H3Index cell_ = 0;
+    int res_parent_ = 0;
+    int target_res_ = 0;
+    int res_ = 0;
+    bool pentagon_ = false;
+    uint8_t faces_[16] = {};
+    int8_t digit_[16] = {};
+    int pos_ = 0;
+    int size_ = 0;
+    H3Index buffer_[kBufferSize];
+    FaceMask buffer_faces_[kBufferSize];
+};
+
+/** A boundary child and its own faces that lie on the parent's input faces. */
+struct BoundaryChild {
+    H3Index cell;
+    FaceMask faces;
+};
+
+/**
+ * Single-pass input range over boundary children, for range-for loops:
+ *
+ *     for (BoundaryChild c : boundary_children(parent, 15)) { ... }
+ */
+class BoundaryChildRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = BoundaryChild;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const BoundaryChild*;
+        using reference = const BoundaryChild&;
+
+        iterator() = default;
+        explicit iterator(BoundaryChildCursor* cursor) : cursor_(cursor) { ++*this; }
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+        iterator& operator++() {
+            if (!cursor_->next(current_.cell, current_.faces)) {
+                cursor_ = nullptr;
+            }
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator& other) const { return cursor_ == other.cursor_; }
+        bool operator!=(const iterator& other) const { return cursor_ != other.cursor_; }
+
+    private:
+        BoundaryChildCursor* cursor_ = nullptr;
+        BoundaryChild current_ = {0, FaceMask::None};
+    };
+
+    BoundaryChildRange(H3Index parent, int target_res, FaceMask input_faces)
+        : cursor_(parent, target_res, input_faces) {}
+
+    /** Starts the walk; a range can only be iterated once. */
+    iterator begin() { return iterator(&cursor_); }
+    iterator end() { return iterator(); }
+
+private:
+    BoundaryChildCursor cursor_;
+};
+
+/** Range form of children_on_boundary_faces. */
+inline BoundaryChildRange boundary_children(H3Index parent, int target_res, FaceMask input_faces = FaceMask::All) {
+    return BoundaryChildRange(parent, target_res, input_faces);
+}
+
+/**
+ * Calls visit for every boundary child of 'parent' at 'target_res', in the
+ * same order as children_on_boundary_faces, without materializing them.
+ *
+ * visit may take (H3Index) or (H3Index, FaceMask), the mask being the child's
+ * own faces that lie on the parent's input faces. If it returns bool,
+ * returning false stops the walk.
+ *
+ * @throws std::invalid_argument if target_res is not in (resolution of parent, 15].
+ */
+template <typename Visitor>
+void for_each_child_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces, Visitor&& visit) {
+    BoundaryChildCursor cursor(parent, target_res, input_faces);
+    H3Index child;
+    FaceMask faces;
+    while (cursor.next(child, faces)) {
+        if constexpr (std::is_invocable_v<Visitor&, H3Index, FaceMask>) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, H3Index, FaceMask>, bool>) {
+                if (!visit(child, faces)) return;
+            } else {
+                visit(child, faces);
+            }
+        } else {
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, H3Index>, bool>) {
+                if (!visit(child)) return;
+            } else {
+                visit(child);
+            }
+        }
+    }
+}
+
+/**
+ * Type-erased overload of for_each_child_on_boundary_faces, for callers that
+ * cannot instantiate the template (e.g. across a library boundary). Return
+ * false from visit to stop.
+ */
+void for_each_child_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces,
+                                      const std::function<bool(H3Index, FaceMask)>& visit);
+
 /**
  * Finds the coarsest ancestor (lowest resolution) such that h still lies on at least
  * one of the specified input_faces.
@@ -40,41 +421,428 @@ std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res,
 H3Index cell_to_coarsest_ancestor_on_faces(H3Index h, const std::set<int>& input_faces = {1,2,3,4,5,6});
 
 /**
- * Returns the cell boundary as a vector of (lon, lat) pairs.
+ * FaceMask overload of cell_to_coarsest_ancestor_on_faces.
  */
-std::vector<std::pair<double, double>> cell_boundary(H3Index cell);
+H3Index cell_to_coarsest_ancestor_on_faces(H3Index h, FaceMask input_faces);
+
+/**
+ * Batch form of cell_to_coarsest_ancestor_on_faces, e.g. for bucketing cells
+ * by how far up the hierarchy they stay on the boundary.
+ *
+ * Never throws and performs no allocation. Any of the output arrays may be
+ * null: out_ancestors receives the coarsest ancestor, out_res its resolution
+ * and out_status E_SUCCESS or E_CELL_INVALID (header check only). Invalid
+ * cells get H3_NULL and resolution -1.
+ */
+void cells_to_coarsest_ancestors_on_faces(const H3Index* cells, size_t count, FaceMask input_faces,
+                                          H3Index* out_ancestors, int* out_res, H3Error* out_status) noexcept;
+
+/**
+ * The result of every geometry function: one or more polygon parts, each an
+ * outer ring followed by its holes, in a single contiguous buffer.
+ *
+ * coords holds the interleaved (lon, lat) of every ring, back to back. Ring j
+ * is the points [ring_offsets[j], ring_offsets[j + 1]) and part k is the
+ * rings [part_offsets[k], part_offsets[k + 1]). Rings are closed; outer rings
+ * run clockwise and holes counter-clockwise. Moving a PolygonResult moves
+ * its three buffers without copying them.
+ */
+struct PolygonResult {
+    std::vector<double> coords;
+    std::vector<uint32_t> ring_offsets{0};
+    std::vector<uint32_t> part_offsets{0};
+
+    size_t num_points() const { return coords.size() / 2; }
+    size_t num_rings() const { return ring_offsets.empty() ? 0 : ring_offsets.size() - 1; }
+    size_t num_parts() const { return part_offsets.empty() ? 0 : part_offsets.size() - 1; }
+    bool empty() const { return num_rings() == 0; }
+
+    std::pair<double, double> point(size_t i) const { return {coords[2 * i], coords[2 * i + 1]}; }
+
+    /** Ring j as (lon, lat) pairs. Copies; meant for tests and small callers. */
+    std::vector<std::pair<double, double>> ring(size_t j) const {
+        std::vector<std::pair<double, double>> result;
+        result.reserve(ring_offsets[j + 1] - ring_offsets[j]);
+        for (size_t i = ring_offsets[j]; i < ring_offsets[j + 1]; ++i) {
+            result.push_back(point(i));
+        }
+        return result;
+    }
+
+    /** The first part's outer ring, or nothing if there are no parts. */
+    std::vector<std::pair<double, double>> outer() const {
+        return empty() ? std::vector<std::pair<double, double>>() : ring(0);
+    }
+
+    /** Building: add a ring's points, end the ring, and end the part after its last ring. */
+    void add_point(double lon, double lat) {
+        coords.push_back(lon);
+        coords.push_back(lat);
+    }
+    void end_ring() { ring_offsets.push_back(static_cast<uint32_t>(num_points())); }
+    void end_part() { part_offsets.push_back(static_cast<uint32_t>(num_rings())); }
+
+    bool operator==(const PolygonResult& other) const {
+        return coords == other.coords && ring_offsets == other.ring_offsets && part_offsets == other.part_offsets;
+    }
+    bool operator!=(const PolygonResult& other) const { return !(*this == other); }
+};
+
+/**
+ * Returns the cell boundary: one part of one ring.
+ */
+PolygonResult cell_boundary(H3Index cell);
 
 /**
  * Returns the merged boundary polygon of all boundary children at target_res.
+ * The outline is traced along the children's exterior edges in perimeter
+ * order (see children_on_boundary_faces_perimeter), linear in the number of
+ * boundary children; pentagon parents, and traces that fail to close, fall
+ * back to cell_polygons_from_children with its holes dropped.
+ *
+ * This is only the outer outline: a single ring for hexagon parents, never
+ * any holes, and it stays the traced ring rather than h3lib's polygons.
+ * Callers that need every part and hole of the union, e.g. the band's hole
+ * where the interior children would be, should use
+ * cell_polygons_from_children instead.
  * @param parent Parent H3 cell
  * @param target_res Resolution for boundary children
- * @return Vector of (lon, lat) pairs representing the merged boundary polygon
+ * @return The outline, one outer ring per part.
+ */
+PolygonResult cell_boundary_from_children(H3Index parent, int target_res);
+
+/** How a set of cells is merged into polygons. */
+enum class OutlineBackend {
+    H3,     ///< h3lib cellsToLinkedMultiPolygon, falling back to Boost on error
+    Boost,  ///< Cascaded Boost.Geometry union
+};
+
+/**
+ * Every polygon of the union of the boundary children at target_res, holes
+ * included, where cell_boundary_from_children only returns the outer rings.
+ * Boundary children form a band, so this is normally one part whose hole
+ * is the region of the interior children.
+ */
+PolygonResult cell_polygons_from_children(H3Index parent, int target_res,
+                                          OutlineBackend backend = OutlineBackend::H3);
+
+/** Where the buffer distance is applied. */
+enum class BufferProjection : uint8_t {
+    /**
+     * In lon/lat, with buffer_meters converted to degrees by the average of
+     * the latitude and longitude scales. Away from the equator this buffers
+     * too far north-south and too little east-west. Auto buffers use the
+     * longitude scale alone, so they reach at least their distance everywhere.
+     */
+    Degrees,
+    /**
+     * In meters, in an azimuthal equidistant projection about the cell's
+     * center, then projected back: an isotropic buffer at every latitude.
+     */
+    LocalAzimuthalEquidistant,
+};
+
+/**
+ * The furthest, in meters, that any descendant at descendant_res reaches
+ * outside its ancestor cell at res (0 if descendant_res == res). Read from a
+ * table generated offline by tools/generate_overhang_table from H3's planar
+ * aperture-7 geometry, with a 1.1 safety factor; pentagon selects the
+ * pentagon row. This is the buffer the auto modes below use.
+ * @throws std::invalid_argument unless 0 <= res <= descendant_res <= 15.
  */
-std::vector<std::pair<double, double>> cell_boundary_from_children(H3Index parent, int target_res);
+double max_descendant_overhang(int res, int descendant_res, bool pentagon = false);
 
 /**
  * Returns a buffered polygon of a single cell (simple buffer, no children).
  * @param cell H3 cell index
- * @param buffer_meters Buffer distance in meters. If < 0, auto-calculates.
- * @return Vector of (lon, lat) pairs representing the buffered polygon
+ * @param buffer_meters Buffer distance in meters. If < 0, the overhang of the
+ *        cell's res 15 descendants (max_descendant_overhang).
+ * @param projection Where the buffer is applied (see BufferProjection).
+ * @return The buffered polygon.
+ * @throws std::invalid_argument if buffer_meters is NaN or infinite.
  */
-std::vector<std::pair<double, double>> get_buffered_h3_polygon(H3Index cell, double buffer_meters = -1.0);
+PolygonResult get_buffered_h3_polygon(H3Index cell, double buffer_meters = -1.0,
+                                      BufferProjection projection = BufferProjection::Degrees);
 
 /**
  * Returns a buffered polygon that is guaranteed to contain all res 15 children.
- * Uses Boost.Geometry for polygon buffering.
+ * Convex bases (the hull) are offset directly; the exact outline is buffered
+ * with Boost.Geometry.
  * 
  * @param cell H3 cell index.
  * @param intermediate_res Resolution for initial boundary computation (default: 10).
- * @param buffer_meters Buffer distance in meters. If < 0, auto-calculates as 100% of intermediate edge length.
- * @param use_convex_hull If true, use fast convex hull. If false, union cells for accurate boundary.
- * @return Vector of (longitude, latitude) pairs representing the buffered polygon vertices.
+ * @param buffer_meters Buffer distance in meters. If < 0, the overhang of the intermediate
+ *        children's res 15 descendants (max_descendant_overhang).
+ * @param use_convex_hull If true, use the convex hull of the boundary children's exterior
+ *        vertices (the traced outline, hulled in linear time). If false, use the exact outline of the
+ *        boundary children, as in cell_boundary_from_children.
+ * @param projection Where the buffer is applied (see BufferProjection).
+ * @return The buffered polygon: every part and hole the buffer produces.
+ * @throws std::invalid_argument if buffer_meters is NaN or infinite.
  */
-std::vector<std::pair<double, double>> get_buffered_boundary_polygon(
+PolygonResult get_buffered_boundary_polygon(
     H3Index cell,
     int intermediate_res = 10,
     double buffer_meters = -1.0,
-    bool use_convex_hull = true
+    bool use_convex_hull = true,
+    BufferProjection projection = BufferProjection::Degrees
 );
 
+/** Limits for get_containment_polygon. */
+struct ContainmentBudget {
+    /** Hard cap on the polygon's vertices (at least 3). */
+    size_t max_vertices = 32;
+    /** Largest acceptable area over the cell's own area; reported, not enforced. */
+    double max_inflation = 1.25;
+    /** Buffer around the intermediate children; < 0 uses their descendants' overhang. */
+    double buffer_meters = -1.0;
+    /** Intermediate resolutions searched; < 0 means cell_res + 1 and cell_res + 4. */
+    int min_intermediate_res = -1;
+    int max_intermediate_res = -1;
+};
+
+/** Result of get_containment_polygon. */
+struct ContainmentPolygon {
+    /** One part of one closed clockwise ring. */
+    PolygonResult polygon;
+    size_t vertex_count = 0;
+    /** Area over the cell's area, both in the local plane the polygon was built in. */
+    double inflation = 0;
+    /** Intermediate resolution the polygon was built from. */
+    int intermediate_res = -1;
+    /** Points per full circle of the round joins; 0 when unbuffered. */
+    int arc_segments = 0;
+    double buffer_meters = 0;
+    /** True if both vertex_count and inflation are within the budget. */
+    bool within_budget = false;
+};
+
+/**
+ * Returns a convex polygon containing the cell's res 15 descendants in at
+ * most budget.max_vertices vertices, for consumers (spatial indexes, GPU
+ * culling) that pay per vertex.
+ *
+ * Each intermediate resolution in the budget's range gives a candidate: the
+ * convex hull of the boundary children, buffered by buffer_meters with round
+ * joins of several segment counts, then simplified by only ever moving edges
+ * outward. The least inflated candidate wins; the search stops once a finer
+ * resolution improves inflation by less than 0.5%. Buffering uses a local
+ * equirectangular plane scaled at the region's extreme latitude, where plane
+ * distances are never longer than on the ground.
+ *
+ * @throws std::invalid_argument if max_vertices < 3 or the cell is res 15.
+ */
+ContainmentPolygon get_containment_polygon(H3Index cell, const ContainmentBudget& budget = ContainmentBudget());
+
+/**
+ * Polygons of a batch call in compressed sparse row form, one level above
+ * PolygonResult: polygon i is the parts [polygon_offsets[i], polygon_offsets[i + 1]),
+ * part k the rings [part_offsets[k], part_offsets[k + 1]) and ring j the
+ * points [ring_offsets[j], ring_offsets[j + 1]) of coords.
+ */
+struct PolygonBatch {
+    /** Interleaved lon, lat of every ring, back to back. */
+    std::vector<double> coords;
+    /** count + 1 entries, indexing part_offsets. */
+    std::vector<uint64_t> polygon_offsets;
+    /** One entry per part plus one, indexing ring_offsets. */
+    std::vector<uint64_t> part_offsets;
+    /** One entry per ring plus one, counting points (coordinate pairs). */
+    std::vector<uint64_t> ring_offsets;
+    /**
+     * Per cell: E_SUCCESS, E_CELL_INVALID for an invalid cell or E_RES_DOMAIN
+     * for a resolution argument the cell cannot take. Failed cells get no parts.
+     */
+    std::vector<H3Error> status;
+
+    size_t size() const { return status.size(); }
+
+    /** Polygon i, copied out as the single-cell function returns it. */
+    PolygonResult polygon(size_t i) const {
+        PolygonResult result;
+        for (uint64_t k = polygon_offsets[i]; k < polygon_offsets[i + 1]; ++k) {
+            for (uint64_t j = part_offsets[k]; j < part_offsets[k + 1]; ++j) {
+                result.coords.insert(result.coords.end(), coords.begin() + 2 * ring_offsets[j],
+                                     coords.begin() + 2 * ring_offsets[j + 1]);
+                result.end_ring();
+            }
+            result.end_part();
+        }
+        return result;
+    }
+};
+
+/*
+ * Batch forms of the geometry functions: one shared set of arguments for
+ * every cell, computed on the shared thread pool (options.num_threads;
+ * split_depth is not used). Results are identical to calling the single-cell
+ * function per cell, polygon cache included. Per-cell failures go to
+ * PolygonBatch::status; a NaN or infinite buffer_meters, which every cell
+ * would fail on, throws std::invalid_argument before any cell is computed.
+ */
+PolygonBatch cell_boundaries(const H3Index* cells, size_t count, const ParallelOptions& options = {});
+
+PolygonBatch cell_boundaries_from_children(const H3Index* cells, size_t count, int target_res,
+                                           const ParallelOptions& options = {});
+
+PolygonBatch get_buffered_h3_polygons(const H3Index* cells, size_t count, double buffer_meters = -1.0,
+                                      BufferProjection projection = BufferProjection::Degrees,
+                                      const ParallelOptions& options = {});
+
+PolygonBatch get_buffered_boundary_polygons(const H3Index* cells, size_t count, int intermediate_res = 10,
+                                            double buffer_meters = -1.0, bool use_convex_hull = true,
+                                            BufferProjection projection = BufferProjection::Degrees,
+                                            const ParallelOptions& options = {});
+
+/** Counters of the polygon cache; see set_polygon_cache_capacity. */
+struct PolygonCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;           ///< Approximate memory held by cached polygons
+    size_t capacity_bytes = 0;  ///< Current byte budget (0 = disabled)
+};
+
+/**
+ * Sets the byte budget of the process-wide cache in front of
+ * cell_boundary_from_children, get_buffered_h3_polygon and
+ * get_buffered_boundary_polygon. Entries are keyed by function, cell and
+ * every resolution/buffer argument, and the least recently used are evicted
+ * once the budget is exceeded. Lookups are sharded, so concurrent callers
+ * do not serialize on a single lock.
+ *
+ * The cache is disabled (0 bytes) by default; setting 0 disables it again
+ * and drops every entry. Shrinking the budget evicts immediately.
+ */
+void set_polygon_cache_capacity(size_t bytes);
+
+/** Drops every cached polygon and resets the counters. */
+void clear_polygon_cache();
+
+/** Snapshot of the polygon cache counters. */
+PolygonCacheStats polygon_cache_stats();
+
+/** Which function a polygon store was generated with. */
+enum class StoredPolygon : uint32_t {
+    BoundaryFromChildren,  ///< cell_boundary_from_children(cell, target_res)
+    BufferedBoundary,      ///< get_buffered_boundary_polygon(cell, target_res, buffer_meters, use_convex_hull, projection)
+};
+
+/** The configuration of a polygon store: one polygon for every cell of cell_res. */
+struct PolygonStoreSpec {
+    StoredPolygon function = StoredPolygon::BufferedBoundary;
+    int cell_res = 6;
+    int target_res = 10;  ///< target_res, or intermediate_res for BufferedBoundary
+    double buffer_meters = -1.0;
+    bool use_convex_hull = true;
+    BufferProjection projection = BufferProjection::Degrees;
+};
+
+/** Options for build_polygon_store. */
+struct PolygonStoreBuildOptions {
+    /** Threads to use, caller included; 0 means all hardware threads. */
+    int num_threads = 0;
+    /** Cells computed between checkpoints. */
+    size_t chunk_size = 4096;
+    /** Where progress is saved; empty means the output path plus ".partial". */
+    std::string checkpoint_path;
+    /** Called after every checkpoint with (cells done, total cells). */
+    std::function<void(size_t, size_t)> progress;
+};
+
+/**
+ * Computes the polygon of every cell of spec.cell_res in parallel and writes
+ * them to a polygon store file at 'path' (see PolygonStore).
+ *
+ * Polygons are appended to a checkpoint file after every chunk of cells. If
+ * the build is interrupted, calling it again with the same spec resumes after
+ * the last complete chunk. The store is written to a temporary file and
+ * renamed into place, so 'path' never holds a partial store.
+ *
+ * @throws std::invalid_argument if target_res is not in (cell_res, 15].
+ * @throws std::runtime_error on I/O errors, or if the checkpoint was written for another spec.
+ */
+void build_polygon_store(const std::string& path, const PolygonStoreSpec& spec,
+                         const PolygonStoreBuildOptions& options = {});
+
+/**
+ * A polygon inside a PolygonStore, laid out as in PolygonResult: num_points
+ * (lon, lat) pairs interleaved in coords, and its slices of the store's ring
+ * and part offsets (num_rings + 1 and num_parts + 1 entries). The offsets
+ * count from the start of the store; subtract the first entry for positions
+ * within the polygon. Points into the mapped file and stays valid as long as
+ * the store. coords is null if the cell is not in the store.
+ */
+struct PolygonView {
+    const double* coords = nullptr;
+    size_t num_points = 0;
+    const uint64_t* ring_offsets = nullptr;
+    size_t num_rings = 0;
+    const uint64_t* part_offsets = nullptr;
+    size_t num_parts = 0;
+
+    explicit operator bool() const { return coords != nullptr; }
+    std::pair<double, double> operator[](size_t i) const { return {coords[2 * i], coords[2 * i + 1]}; }
+
+    /** A copy of the polygon. */
+    PolygonResult to_result() const {
+        PolygonResult result;
+        result.coords.assign(coords, coords + 2 * num_points);
+        for (size_t j = 1; j <= num_rings; ++j) {
+            result.ring_offsets.push_back(static_cast<uint32_t>(ring_offsets[j] - ring_offsets[0]));
+        }
+        for (size_t k = 1; k <= num_parts; ++k) {
+            result.part_offsets.push_back(static_cast<uint32_t>(part_offsets[k] - part_offsets[0]));
+        }
+        return result;
+    }
+};
+
+/**
+ * Read-only, memory-mapped polygon store written by build_polygon_store.
+ *
+ * The file holds a header with the PolygonStoreSpec, the sorted cell keys,
+ * the polygons' part, ring and point offsets (the PolygonBatch layout) and one
+ * flat array of (lon, lat) doubles. Opening maps it and checks, in one pass over the keys and offsets,
+ * that they are sorted and in bounds; the coordinates are not parsed. find() then binary
+ * searches the keys and returns a view into the mapping without copying.
+ * Files are native-endian and rejected on a machine of the other byte order.
+ */
+class PolygonStore {
+public:
+    /** @throws std::runtime_error if the file cannot be mapped or is not a valid store. */
+    explicit PolygonStore(const std::string& path);
+    ~PolygonStore();
+
+    PolygonStore(PolygonStore&&) noexcept;
+    PolygonStore& operator=(PolygonStore&&) noexcept;
+
+    const PolygonStoreSpec& spec() const { return spec_; }
+
+    /** Number of stored cells. */
+    size_t size() const { return count_; }
+
+    /** Zero-copy lookup; an empty view if the cell is not stored. */
+    PolygonView find(H3Index cell) const;
+
+    /**
+     * The stored polygon of a cell, or, on a miss, the polygon computed live
+     * with the store's spec (through the polygon cache, if enabled).
+     */
+    PolygonResult polygon(H3Index cell) const;
+
+private:
+    struct Mapping;
+
+    std::unique_ptr<Mapping> mapping_;
+    PolygonStoreSpec spec_;
+    size_t count_ = 0;
+    const H3Index* keys_ = nullptr;
+    const uint64_t* polygon_offsets_ = nullptr;
+    const uint64_t* part_offsets_ = nullptr;
+    const uint64_t* ring_offsets_ = nullptr;
+    const double* coords_ = nullptr;
+};
+
 } // namespace h3_toolkit
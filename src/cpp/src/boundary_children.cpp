@@ -0,0 +1,522 @@
+/**
+ * @file boundary_children.cpp
+ * @brief Enumeration of the children of a cell that lie on its boundary faces.
+ *
+ * Everything is built on BoundaryChildCursor, a resumable depth-first walk
+ * over the child tree pruned by the downward face tables. The vector,
+ * visitor and range forms in h3_toolkit.hpp are thin layers over it.
+ *
+ * Counting, rank and select use the per-subtree counts in kBoundaryCount:
+ * at each level, the subtrees of the earlier sibling digits are skipped in
+ * one step, so all of them are O(target_res - parent resolution).
+ *
+ * Below a hexagon, the boundary children's digit suffixes depend only on the
+ * parity of the first child level, the face mask and the depth, never on the
+ * base cell or the parent's own digits. children_on_boundary_faces keeps the
+ * suffix list for each (parity, mask, depth) it has seen, up to a byte
+ * budget, and stamps the parent's prefix onto it instead of walking the tree.
+ *
+ * Perimeter order uses the fact that the six outer children sit around the
+ * parent in the same cyclic order as its faces (detail::kPerimeterCycle), at
+ * both parities. A cell's stretch of the parent's edge is one arc of its own
+ * faces, so visiting the children from the one at the start of that arc, in
+ * cyclic order, walks the edge.
+ */
+
+#include "h3_toolkit.hpp"
+#include "face_tables.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace h3_toolkit {
+
+namespace {
+
+void check_target_res(int res_parent, int target_res) {
+    if (target_res <= res_parent) {
+        throw std::invalid_argument("target_res must be greater than parent cell resolution");
+    }
+    if (target_res > 15) {
+        throw std::invalid_argument("target_res cannot exceed 15");
+    }
+}
+
+/** True if the cell is a pentagon, read off the index bits. */
+bool is_pentagon_cell(H3Index h, int res) {
+    return detail::is_pentagon_base_cell(h) && detail::leading_digits_zero(h, res);
+}
+
+/** Boundary descendants at target_res of a hexagon at res whose own boundary faces are mask. */
+uint64_t subtree_count(int res, int target_res, uint8_t mask) {
+    return detail::kBoundaryCount.count[(res + 1) & 1][target_res - res][mask];
+}
+
+/**
+ * Digit of the child at res whose subtree holds the k-th boundary descendant
+ * of a cell with faces mask; k is reduced to the rank within that subtree.
+ * The caller guarantees k is in range.
+ */
+int select_child_digit(int res, int target_res, uint8_t mask, bool skip_digit_1, uint64_t& k) {
+    int d = 1;
+    for (; d < 6; ++d) {
+        if (d == 1 && skip_digit_1) {
+            continue;
+        }
+        uint64_t c = subtree_count(res, target_res, detail::kHexDownward.next[res & 1][d][mask]);
+        if (k < c) {
+            break;
+        }
+        k -= c;
+    }
+    return d;
+}
+
+void check_rank(int64_t rank, int64_t limit) {
+    if (rank < 0 || rank > limit) {
+        throw std::out_of_range("rank is outside the boundary child sequence");
+    }
+}
+
+/** Digit suffixes (depth * 3 bits, first child level highest) in traversal order. */
+using SuffixTemplate = std::vector<uint64_t>;
+
+/**
+ * Lazily published suffix templates, one slot per (parity, depth, mask).
+ * Lookups are a single atomic load. The first caller to miss a key walks its
+ * own parent, which it must do anyway, and publishes the suffixes of that
+ * walk with a compare-and-swap; concurrent first callers of one key both walk
+ * and the loser drops its copy. Templates are never evicted: a key that no
+ * longer fits the byte budget is marked too large, so later calls go straight
+ * to the tree walk.
+ */
+class SuffixTemplateCache {
+public:
+    static constexpr size_t kByteBudget = size_t(64) << 20;
+
+    static SuffixTemplateCache& instance() {
+        static SuffixTemplateCache cache;
+        return cache;
+    }
+
+    ~SuffixTemplateCache() {
+        for (auto& by_depth : slots_) {
+            for (auto& by_mask : by_depth) {
+                for (auto& slot : by_mask) {
+                    const SuffixTemplate* found = slot.load(std::memory_order_relaxed);
+                    if (found != &too_large_) {
+                        delete found;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Template for hexagon parents at res_parent, or nullptr. 'publishable'
+     * says whether the key is still open, i.e. the caller should publish.
+     */
+    const SuffixTemplate* find(int res_parent, int target_res, uint8_t mask, bool& publishable) {
+        const SuffixTemplate* found = slot(res_parent, target_res, mask).load(std::memory_order_acquire);
+        publishable = found == nullptr;
+        return found == &too_large_ ? nullptr : found;
+    }
+
+    /** Publishes the suffixes of 'children', the walk of a hexagon parent at res_parent. */
+    void publish(int res_parent, int target_res, uint8_t mask, const std::vector<H3Index>& children) {
+        std::atomic<const SuffixTemplate*>& target = slot(res_parent, target_res, mask);
+        const SuffixTemplate* expected = nullptr;
+        size_t bytes = children.size() * sizeof(uint64_t);
+        size_t used = bytes_used_.load(std::memory_order_relaxed);
+        do {
+            if (bytes > kByteBudget - used) {
+                target.compare_exchange_strong(expected, &too_large_, std::memory_order_release);
+                return;
+            }
+        } while (!bytes_used_.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+        int shift = detail::digit_offset(target_res);
+        uint64_t suffix_bits = (UINT64_C(1) << ((target_res - res_parent) * 3)) - 1;
+        auto suffixes = std::make_unique<SuffixTemplate>(children.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            (*suffixes)[i] = (children[i] >> shift) & suffix_bits;
+        }
+        if (target.compare_exchange_strong(expected, suffixes.get(), std::memory_order_release)) {
+            suffixes.release();
+        } else {
+            bytes_used_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    SuffixTemplateCache() = default;
+
+    std::atomic<const SuffixTemplate*>& slot(int res_parent, int target_res, uint8_t mask) {
+        return slots_[(res_parent + 1) & 1][target_res - res_parent][mask];
+    }
+
+    std::atomic<const SuffixTemplate*> slots_[2][16][detail::kNumMasks] = {};
+    std::atomic<size_t> bytes_used_{0};
+    const SuffixTemplate too_large_{};  // sentinel: the key does not fit the budget
+};
+
+} // namespace
+
+BoundaryChildCursor::BoundaryChildCursor(H3Index parent, int target_res, FaceMask input_faces) {
+    res_parent_ = getResolution(parent);
+    check_target_res(res_parent_, target_res);
+    target_res_ = target_res;
+
+    // Children are formed by writing digits straight into the index, whose
+    // resolution field is set to target_res up front: only complete paths
+    // are emitted, and the digits below target_res are already 7 in the parent.
+    cell_ = (parent & ~detail::kResMask) | (static_cast<uint64_t>(target_res) << detail::kResOffset);
+    faces_[res_parent_] = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+
+    // A pentagon has no child at digit 1 (the deleted K subsequence). Only the
+    // parent itself can be a pentagon here: deeper pentagons are center
+    // children, which never lie on a boundary face.
+    pentagon_ = is_pentagon_cell(parent, res_parent_);
+
+    res_ = res_parent_ + 1;
+    digit_[res_] = 1;  // the center child (digit 0) is never on a boundary face
+}
+
+BoundaryChildCursor::BoundaryChildCursor(H3Index parent, int target_res, FaceMask input_faces, int64_t start_rank)
+    : BoundaryChildCursor(parent, target_res, input_faces) {
+    int64_t total = count_children_on_boundary_faces(parent, target_res, input_faces);
+    check_rank(start_rank, total);
+    if (start_rank == total) {
+        res_ = res_parent_;  // positioned at the end
+        return;
+    }
+
+    // Lay down the path to the start child as if the walk had just got there:
+    // digit_ holds the next digit to try at each level.
+    uint64_t k = static_cast<uint64_t>(start_rank);
+    for (int res = res_parent_ + 1;; ++res) {
+        int d = select_child_digit(res, target_res_, faces_[res - 1], pentagon_ && res == res_parent_ + 1, k);
+        if (res == target_res_) {
+            digit_[res] = static_cast<int8_t>(d);
+            res_ = res;
+            return;
+        }
+        int offset = detail::digit_offset(res);
+        cell_ = (cell_ & ~(UINT64_C(0x7) << offset)) | (static_cast<uint64_t>(d) << offset);
+        faces_[res] = detail::kHexDownward.next[res & 1][d][faces_[res - 1]];
+        digit_[res] = static_cast<int8_t>(d + 1);
+    }
+}
+
+bool BoundaryChildCursor::refill() {
+    // Work on locals so the compiler does not have to assume the buffer
+    // stores alias the walk state.
+    H3Index cell = cell_;
+    int res = res_;
+    int size = 0;
+    while (res > res_parent_ && size < kBufferSize) {
+        int d = digit_[res]++;
+        if (d > 6) {
+            --res;
+            continue;
+        }
+        if (pentagon_ && res == res_parent_ + 1 && d == 1) {
+            continue;
+        }
+        uint8_t mapped_faces = detail::kHexDownward.next[res & 1][d][faces_[res - 1]];
+        if (mapped_faces == 0) {
+            continue;
+        }
+        int offset = detail::digit_offset(res);
+        cell = (cell & ~(UINT64_C(0x7) << offset)) | (static_cast<uint64_t>(d) << offset);
+        if (res == target_res_) {
+            buffer_[size] = cell;
+            buffer_faces_[size] = static_cast<FaceMask>(mapped_faces);
+            ++size;
+        } else {
+            faces_[res] = mapped_faces;
+            digit_[++res] = 1;
+        }
+    }
+    cell_ = cell;
+    res_ = res;
+    pos_ = 0;
+    size_ = size;
+    return size > 0;
+}
+
+void for_each_child_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces,
+                                      const std::function<bool(H3Index, FaceMask)>& visit) {
+    BoundaryChildCursor cursor(parent, target_res, input_faces);
+    H3Index child;
+    FaceMask faces;
+    while (cursor.next(child, faces) && visit(child, faces)) {
+    }
+}
+
+int64_t count_children_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces) {
+    int res_parent = getResolution(parent);
+    check_target_res(res_parent, target_res);
+
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    uint64_t count = subtree_count(res_parent, target_res, mask);
+    if (is_pentagon_cell(parent, res_parent)) {
+        count -= subtree_count(res_parent + 1, target_res, detail::kHexDownward.next[(res_parent + 1) & 1][1][mask]);
+    }
+    return static_cast<int64_t>(count);
+}
+
+H3Index boundary_child_at(H3Index parent, int target_res, FaceMask input_faces, int64_t k) {
+    int res_parent = getResolution(parent);
+    int64_t total = count_children_on_boundary_faces(parent, target_res, input_faces);
+    check_rank(k, total - 1);
+
+    bool pentagon = is_pentagon_cell(parent, res_parent);
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    H3Index h = (parent & ~detail::kResMask) | (static_cast<uint64_t>(target_res) << detail::kResOffset);
+    uint64_t rank = static_cast<uint64_t>(k);
+    for (int res = res_parent + 1; res <= target_res; ++res) {
+        int d = select_child_digit(res, target_res, mask, pentagon && res == res_parent + 1, rank);
+        int offset = detail::digit_offset(res);
+        h = (h & ~(UINT64_C(0x7) << offset)) | (static_cast<uint64_t>(d) << offset);
+        mask = detail::kHexDownward.next[res & 1][d][mask];
+    }
+    return h;
+}
+
+int64_t boundary_child_rank(H3Index parent, H3Index child, FaceMask input_faces) {
+    int res_parent = getResolution(parent);
+    int target_res = getResolution(child);
+    check_target_res(res_parent, target_res);
+    if (detail::index_to_parent(child, res_parent) != parent) {
+        throw std::invalid_argument("child is not a descendant of parent");
+    }
+
+    bool pentagon = is_pentagon_cell(parent, res_parent);
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    uint64_t rank = 0;
+    for (int res = res_parent + 1; res <= target_res; ++res) {
+        bool skip_digit_1 = pentagon && res == res_parent + 1;
+        int d = detail::get_digit(child, res);
+        for (int earlier = 1; earlier < d; ++earlier) {
+            if (earlier == 1 && skip_digit_1) {
+                continue;
+            }
+            rank += subtree_count(res, target_res, detail::kHexDownward.next[res & 1][earlier][mask]);
+        }
+        mask = detail::kHexDownward.next[res & 1][d][mask];
+        if (mask == 0 || (d == 1 && skip_digit_1)) {
+            throw std::invalid_argument("child does not lie on the requested boundary faces");
+        }
+    }
+    return static_cast<int64_t>(rank);
+}
+
+std::vector<H3Index> boundary_children_in_range(H3Index parent, int target_res, FaceMask input_faces,
+                                                int64_t begin_rank, int64_t end_rank) {
+    int64_t total = count_children_on_boundary_faces(parent, target_res, input_faces);
+    check_rank(end_rank, total);
+    check_rank(begin_rank, end_rank);
+
+    std::vector<H3Index> result;
+    result.reserve(static_cast<size_t>(end_rank - begin_rank));
+    BoundaryChildCursor cursor(parent, target_res, input_faces, begin_rank);
+    H3Index child;
+    FaceMask faces;
+    for (int64_t i = begin_rank; i < end_rank && cursor.next(child, faces); ++i) {
+        result.push_back(child);
+    }
+    return result;
+}
+
+int64_t count_children_on_boundary_faces(H3Index parent, int target_res, const std::set<int>& input_faces) {
+    return count_children_on_boundary_faces(parent, target_res, to_face_mask(input_faces));
+}
+
+std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res, FaceMask input_faces) {
+    int res_parent = getResolution(parent);
+    check_target_res(res_parent, target_res);
+
+    // Pentagons have their own digit-1 gap, so they keep the tree walk.
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    bool pentagon = is_pentagon_cell(parent, res_parent);
+    bool publishable = false;
+    SuffixTemplateCache& templates = SuffixTemplateCache::instance();
+    const SuffixTemplate* suffixes = pentagon ? nullptr : templates.find(res_parent, target_res, mask, publishable);
+    if (suffixes) {
+        int shift = detail::digit_offset(target_res);
+        uint64_t suffix_bits = ((UINT64_C(1) << ((target_res - res_parent) * 3)) - 1) << shift;
+        H3Index prefix = (parent & ~detail::kResMask & ~suffix_bits) |
+                         (static_cast<uint64_t>(target_res) << detail::kResOffset);
+        std::vector<H3Index> result(suffixes->size());
+        const uint64_t* in = suffixes->data();
+        H3Index* out = result.data();
+        for (size_t i = 0, n = suffixes->size(); i < n; ++i) {
+            out[i] = prefix | (in[i] << shift);
+        }
+        return result;
+    }
+
+    std::vector<H3Index> result;
+    result.reserve(static_cast<size_t>(count_children_on_boundary_faces(parent, target_res, input_faces)));
+    for_each_child_on_boundary_faces(parent, target_res, input_faces, [&](H3Index child) {
+        result.push_back(child);
+    });
+    if (!pentagon && publishable) {
+        templates.publish(res_parent, target_res, mask, result);
+    }
+    return result;
+}
+
+std::vector<H3Index> children_on_boundary_faces_parallel(H3Index parent, int target_res, FaceMask input_faces,
+                                                         const ParallelOptions& options) {
+    int res_parent = getResolution(parent);
+    check_target_res(res_parent, target_res);
+    int num_threads = detail::resolve_num_threads(options.num_threads);
+    int max_split = target_res - res_parent - 1;
+    if (num_threads <= 1 || max_split < 1) {
+        return children_on_boundary_faces(parent, target_res, input_faces);
+    }
+
+    // Enough subtrees per thread that stealing can even out their sizes
+    constexpr int64_t kTasksPerThread = 64;
+    int split = options.split_depth;
+    if (split <= 0) {
+        split = 1;
+        while (split < max_split &&
+               count_children_on_boundary_faces(parent, res_parent + split, input_faces) < kTasksPerThread * num_threads) {
+            ++split;
+        }
+    }
+    split = std::min(split, max_split);
+
+    // Subtree roots in traversal order; each root's own face mask continues
+    // the walk exactly where the serial traversal would.
+    std::vector<BoundaryChild> roots;
+    roots.reserve(static_cast<size_t>(count_children_on_boundary_faces(parent, res_parent + split, input_faces)));
+    for_each_child_on_boundary_faces(parent, res_parent + split, input_faces, [&](H3Index cell, FaceMask faces) {
+        roots.push_back({cell, faces});
+    });
+    std::vector<size_t> offsets(roots.size() + 1, 0);
+    for (size_t i = 0; i < roots.size(); ++i) {
+        offsets[i + 1] = offsets[i] + static_cast<size_t>(
+            count_children_on_boundary_faces(roots[i].cell, target_res, roots[i].faces));
+    }
+
+    std::vector<H3Index> result(offsets.back());
+    detail::ThreadPool::shared().parallel_for(roots.size(), [&](size_t i) {
+        H3Index* out = result.data() + offsets[i];
+        for_each_child_on_boundary_faces(roots[i].cell, target_res, roots[i].faces, [&](H3Index child) {
+            *out++ = child;
+        });
+    }, num_threads);
+    return result;
+}
+
+PerimeterChildren children_on_boundary_faces_perimeter(H3Index parent, int target_res, FaceMask input_faces) {
+    int res_parent = getResolution(parent);
+    check_target_res(res_parent, target_res);
+    bool pentagon = is_pentagon_cell(parent, res_parent);
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+
+    PerimeterChildren result;
+    size_t count = static_cast<size_t>(count_children_on_boundary_faces(parent, target_res, input_faces));
+    result.cells.reserve(count);
+    result.faces.reserve(count);
+    // Parent faces each child touches, to cut the walk into runs afterwards
+    std::vector<uint8_t> touched;
+    touched.reserve(count);
+
+    // Same walk as BoundaryChildCursor, except that each cell's children are
+    // visited in cyclic order from the start of its arc. Besides its faces on
+    // the whole input, each level keeps its faces on every single parent face.
+    H3Index cell = (parent & ~detail::kResMask) | (static_cast<uint64_t>(target_res) << detail::kResOffset);
+    uint8_t faces[16];
+    uint8_t per_face[16][detail::kNumFaces];
+    int8_t start[16];
+    int8_t step[16];
+    faces[res_parent] = mask;
+    for (int f = 0; f < detail::kNumFaces; ++f) {
+        per_face[res_parent][f] = mask & (1 << f);
+    }
+    start[res_parent] = static_cast<int8_t>(detail::arc_start_pos(mask));
+    int res = res_parent + 1;
+    step[res] = 0;
+    while (res > res_parent) {
+        int k = step[res]++;
+        if (k == detail::kNumFaces) {
+            --res;
+            continue;
+        }
+        int d = detail::kPerimeterCycle[(start[res - 1] + k) % detail::kNumFaces];
+        if (pentagon && res == res_parent + 1 && d == 1) {
+            continue;
+        }
+        const uint8_t* down = detail::kHexDownward.next[res & 1][d];
+        uint8_t mapped_faces = down[faces[res - 1]];
+        if (mapped_faces == 0) {
+            continue;
+        }
+        int offset = detail::digit_offset(res);
+        cell = (cell & ~(UINT64_C(0x7) << offset)) | (static_cast<uint64_t>(d) << offset);
+        if (res == target_res) {
+            uint8_t parent_faces = 0;
+            for (int f = 0; f < detail::kNumFaces; ++f) {
+                parent_faces |= static_cast<uint8_t>((down[per_face[res - 1][f]] != 0) << f);
+            }
+            result.cells.push_back(cell);
+            result.faces.push_back(static_cast<FaceMask>(mapped_faces));
+            touched.push_back(parent_faces);
+        } else {
+            faces[res] = mapped_faces;
+            for (int f = 0; f < detail::kNumFaces; ++f) {
+                per_face[res][f] = down[per_face[res - 1][f]];
+            }
+            start[res] = static_cast<int8_t>(detail::arc_start_pos(mapped_faces));
+            step[++res] = 0;
+        }
+    }
+
+    // A full walk starts inside child 4, partway along face 5; rotate it to
+    // begin at the corner cell, the first one on face 4.
+    int start_pos = detail::arc_start_pos(mask);
+    result.closed = mask == detail::kAllFacesMask;
+    if (result.closed) {
+        size_t corner = 0;
+        while (corner < touched.size() && !(touched[corner] & (1 << 3))) {
+            ++corner;
+        }
+        std::rotate(result.cells.begin(), result.cells.begin() + corner, result.cells.end());
+        std::rotate(result.faces.begin(), result.faces.begin() + corner, result.faces.end());
+        std::rotate(touched.begin(), touched.begin() + corner, touched.end());
+    }
+
+    int64_t size = static_cast<int64_t>(touched.size());
+    int64_t pos = 0;
+    for (int k = 0; k < detail::kNumFaces; ++k) {
+        int face = detail::kPerimeterCycle[(start_pos + k) % detail::kNumFaces];
+        uint8_t bit = static_cast<uint8_t>(1 << (face - 1));
+        if (!(mask & bit)) {
+            continue;
+        }
+        int64_t begin = pos;
+        while (begin < size && !(touched[begin] & bit)) {
+            ++begin;
+        }
+        int64_t end = begin;
+        while (end < size && (touched[end] & bit)) {
+            ++end;
+        }
+        result.face_runs.push_back({face, begin, end});
+        pos = begin;
+    }
+    return result;
+}
+
+std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res, const std::set<int>& input_faces) {
+    return children_on_boundary_faces(parent, target_res, to_face_mask(input_faces));
+}
+
+} // namespace h3_toolkit
@@ -0,0 +1,123 @@
+/**
+ * @file convex_offset.cpp
+ * @brief Outward offset of convex rings without bg::buffer.
+ */
+
+#include "convex_offset.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace h3_toolkit {
+namespace detail {
+
+namespace {
+
+/** Turns whose sine is below this count as straight, as in the hull code. */
+constexpr double kStraightSine = 1e-9;
+
+double cross(const OffsetPoint& a, const OffsetPoint& b, const OffsetPoint& c) {
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+double distance(const OffsetPoint& a, const OffsetPoint& b) {
+    return std::hypot(b.x() - a.x(), b.y() - a.y());
+}
+
+} // namespace
+
+bool convex_offset(const OffsetRing& ring, double distance_out, int points_per_circle, OffsetRing& out) {
+    out.clear();
+
+    // Distinct vertices, open, clockwise
+    std::vector<OffsetPoint> v;
+    v.reserve(ring.size());
+    for (const auto& p : ring) {
+        if (v.empty() || p.x() != v.back().x() || p.y() != v.back().y()) {
+            v.push_back(p);
+        }
+    }
+    while (v.size() > 1 && v.front().x() == v.back().x() && v.front().y() == v.back().y()) {
+        v.pop_back();
+    }
+    if (v.size() < 3) {
+        return false;
+    }
+    double area2 = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        const OffsetPoint& a = v[i];
+        const OffsetPoint& b = v[(i + 1) % v.size()];
+        area2 += a.x() * b.y() - b.x() * a.y();
+    }
+    if (area2 > 0) {
+        std::reverse(v.begin(), v.end());
+    }
+
+    // Keep only real turns: a straight vertex would get a degenerate join,
+    // and a slight left turn a full circle
+    std::vector<OffsetPoint> corners;
+    corners.reserve(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        const OffsetPoint& prev = corners.empty() ? v.back() : corners.back();
+        const OffsetPoint& next = v[(i + 1) % v.size()];
+        double sine = cross(prev, v[i], next) / (distance(prev, v[i]) * distance(v[i], next));
+        if (std::isnan(sine)) {
+            return false;
+        }
+        if (sine < -kStraightSine) {
+            corners.push_back(v[i]);
+        } else if (sine > kStraightSine) {
+            return false;
+        }
+    }
+    size_t n = corners.size();
+    if (n < 3) {
+        return false;
+    }
+
+    // Outward (left-hand, for a clockwise ring) unit normal of each edge
+    std::vector<OffsetPoint> normal(n);
+    for (size_t i = 0; i < n; ++i) {
+        const OffsetPoint& a = corners[i];
+        const OffsetPoint& b = corners[(i + 1) % n];
+        double length = distance(a, b);
+        normal[i] = OffsetPoint(-(b.y() - a.y()) / length, (b.x() - a.x()) / length);
+    }
+
+    // At each corner: end of the incoming edge, the arc, start of the outgoing
+    // edge. The arc steps match bg::strategy::buffer::join_round.
+    const double two_pi = 2 * M_PI;
+    double turned = 0;
+    out.reserve(n * 2 + static_cast<size_t>(points_per_circle) + 1);
+    for (size_t i = 0; i < n; ++i) {
+        const OffsetPoint& vertex = corners[i];
+        const OffsetPoint& in = normal[(i + n - 1) % n];
+        const OffsetPoint& on = normal[i];
+        double angle1 = std::atan2(in.y(), in.x());
+        double angle2 = std::atan2(on.y(), on.x());
+        while (angle2 > angle1) {
+            angle2 -= two_pi;
+        }
+        double angle_diff = angle1 - angle2;
+        turned += angle_diff;
+
+        out.push_back(OffsetPoint(vertex.x() + distance_out * in.x(), vertex.y() + distance_out * in.y()));
+        size_t steps = std::max(static_cast<size_t>(std::ceil(points_per_circle * angle_diff / two_pi)), size_t(1));
+        double step = angle_diff / static_cast<double>(steps);
+        double a = angle1 - step;
+        for (size_t k = 0; k + 1 < steps; ++k, a -= step) {
+            out.push_back(OffsetPoint(vertex.x() + distance_out * std::cos(a), vertex.y() + distance_out * std::sin(a)));
+        }
+        out.push_back(OffsetPoint(vertex.x() + distance_out * on.x(), vertex.y() + distance_out * on.y()));
+    }
+    // Right turns that wind more than once make a star, not a convex ring
+    if (std::abs(turned - two_pi) > 1e-6) {
+        out.clear();
+        return false;
+    }
+    out.push_back(out.front());
+    return true;
+}
+
+} // namespace detail
+} // namespace h3_toolkit
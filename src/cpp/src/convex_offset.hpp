@@ -0,0 +1,36 @@
+/**
+ * @file convex_offset.hpp
+ * @brief Outward offset of convex rings without bg::buffer.
+ *
+ * Internal header; used by the buffered polygon functions whenever the ring
+ * to buffer is convex (single cells, convex hulls).
+ *
+ * The offset of a convex polygon by a disk is its edges shifted out along
+ * their normals joined by circular arcs at the vertices, so it needs one
+ * pass over the ring and none of the self-intersection handling a general
+ * buffer does. Arcs are discretized as bg::buffer's join_round does, so both
+ * paths give the same vertices for the same ring.
+ */
+
+#pragma once
+
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+
+namespace h3_toolkit {
+namespace detail {
+
+typedef boost::geometry::model::d2::point_xy<double> OffsetPoint;
+typedef boost::geometry::model::ring<OffsetPoint> OffsetRing;
+
+/**
+ * Offsets a closed ring outward by 'distance', with round joins of
+ * points_per_circle points per full circle. Near-collinear vertices are
+ * dropped first. Returns false, leaving 'out' empty, if what remains is not
+ * a strictly convex ring of at least three vertices; the caller then falls
+ * back to bg::buffer. The result is closed and clockwise.
+ */
+bool convex_offset(const OffsetRing& ring, double distance, int points_per_circle, OffsetRing& out);
+
+} // namespace detail
+} // namespace h3_toolkit
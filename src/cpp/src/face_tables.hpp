@@ -0,0 +1,430 @@
+/**
+ * @file face_tables.hpp
+ * @brief Compile-time face transition tables and H3 index digit helpers.
+ *
+ * Internal header shared by the h3_toolkit translation units. Nothing in here
+ * is part of the public API.
+ *
+ * A face set is stored as a 6-bit mask where bit (f - 1) stands for face f.
+ * All tables are indexed by the raw 3-bit index digit (0-7) so that a digit
+ * pulled straight out of an H3Index can be used without range checks; rows
+ * for digit 0 (center child) and digit 7 (unused) are all zero.
+ */
+
+#pragma once
+
+#include <h3api.h>
+#include <cstdint>
+
+namespace h3_toolkit {
+namespace detail {
+
+constexpr int kNumFaces = 6;
+constexpr int kNumDigits = 8;
+constexpr int kNumMasks = 64;
+constexpr uint8_t kAllFacesMask = 0x3F;
+
+/**
+ * Face mapping tables.
+ *
+ * Structure: [parity][child_pos][child_face] -> parent_face (0 = not on the
+ * parent boundary). Parity is the resolution of the child modulo 2.
+ */
+constexpr int8_t kHexFaceMap[2][kNumDigits][kNumFaces + 1] = {
+    {   // Even resolutions (parity 0)
+        {},
+        {0, 1, 3, 1, 0, 0, 0},   // 1: {2->3, 3->1, 1->1}
+        {0, 0, 2, 0, 6, 0, 2},   // 2: {4->6, 2->2, 6->2}
+        {0, 0, 3, 3, 0, 0, 2},   // 3: {6->2, 2->3, 3->3}
+        {0, 5, 0, 0, 4, 4, 0},   // 4: {1->5, 4->4, 5->4}
+        {0, 5, 0, 1, 0, 5, 0},   // 5: {1->5, 3->1, 5->5}
+        {0, 0, 0, 0, 6, 4, 6},   // 6: {4->6, 5->4, 6->6}
+        {},
+    },
+    {   // Odd resolutions (parity 1)
+        {},
+        {0, 3, 0, 3, 0, 1, 0},   // 1: {3->3, 1->3, 5->1}
+        {0, 0, 6, 2, 0, 0, 6},   // 2: {2->6, 6->6, 3->2}
+        {0, 3, 2, 2, 0, 0, 0},   // 3: {2->2, 1->3, 3->2}
+        {0, 0, 0, 0, 5, 5, 4},   // 4: {4->5, 5->5, 6->4}
+        {0, 1, 0, 0, 5, 1, 0},   // 5: {1->1, 4->5, 5->1}
+        {0, 0, 6, 0, 4, 0, 4},   // 6: {4->4, 2->6, 6->4}
+        {},
+    },
+};
+
+/** Same layout as kHexFaceMap, used when the parent is a pentagon. */
+constexpr int8_t kPentFaceMap[2][kNumDigits][kNumFaces + 1] = {
+    {   // Even resolutions
+        {},
+        {0, 0, 1, 0, 5, 0, 1},   // 1: {4->5, 2->1, 6->1}
+        {0, 0, 2, 2, 0, 0, 1},   // 2: {6->1, 3->2, 2->2}
+        {0, 0, 0, 0, 2, 2, 4},   // 3: {5->2, 4->2, 6->4}
+        {0, 2, 0, 2, 0, 4, 0},   // 4: {3->2, 5->4, 1->2}
+        {0, 0, 0, 0, 5, 3, 5},   // 5: {5->3, 6->5, 4->5}
+        {},
+        {},
+    },
+    {   // Odd resolutions
+        {},
+        {0, 0, 5, 1, 0, 0, 5},   // 1: {2->5, 6->5, 3->1}
+        {0, 2, 1, 1, 0, 0, 0},   // 2: {3->1, 2->1, 1->2}
+        {0, 4, 0, 0, 3, 3, 0},   // 3: {1->4, 4->3, 5->3}
+        {0, 2, 0, 0, 4, 2, 0},   // 4: {1->2, 5->2, 4->4}
+        {0, 0, 5, 0, 3, 0, 3},   // 5: {2->5, 4->3, 6->3}
+        {},
+        {},
+    },
+};
+
+/**
+ * Reversed mapping for hexagonal parents.
+ *
+ * Structure: [parity][child_pos][parent_face] -> mask of child faces lying on
+ * that parent face.
+ */
+constexpr uint8_t kReversedHexFaceMap[2][kNumDigits][kNumFaces + 1] = {
+    {   // Even resolutions
+        {},
+        {0, 0x05, 0, 0x02, 0, 0, 0},   // 1: {1->{1,3}, 3->{2}}
+        {0, 0, 0x22, 0, 0, 0, 0x08},   // 2: {2->{2,6}, 6->{4}}
+        {0, 0, 0x20, 0x06, 0, 0, 0},   // 3: {2->{6}, 3->{2,3}}
+        {0, 0, 0, 0, 0x18, 0x01, 0},   // 4: {4->{4,5}, 5->{1}}
+        {0, 0x04, 0, 0, 0, 0x11, 0},   // 5: {5->{1,5}, 1->{3}}
+        {0, 0, 0, 0, 0x10, 0, 0x28},   // 6: {4->{5}, 6->{4,6}}
+        {},
+    },
+    {   // Odd resolutions
+        {},
+        {0, 0x10, 0, 0x05, 0, 0, 0},   // 1: {3->{1,3}, 1->{5}}
+        {0, 0, 0x04, 0, 0, 0, 0x22},   // 2: {6->{2,6}, 2->{3}}
+        {0, 0, 0x06, 0x01, 0, 0, 0},   // 3: {2->{2,3}, 3->{1}}
+        {0, 0, 0, 0, 0x20, 0x18, 0},   // 4: {5->{4,5}, 4->{6}}
+        {0, 0x11, 0, 0, 0, 0x08, 0},   // 5: {1->{1,5}, 5->{4}}
+        {0, 0, 0, 0, 0x28, 0, 0x02},   // 6: {4->{4,6}, 6->{2}}
+        {},
+    },
+};
+
+/**
+ * Dense face-mask transition table: [parity][digit][mask] -> mask.
+ *
+ * 2 * 8 * 64 bytes, so a whole table stays resident in L1 and every level of
+ * a trace is a single load.
+ */
+struct MaskTransitionTable {
+    uint8_t next[2][kNumDigits][kNumMasks] = {};
+};
+
+/** Builds child-mask -> parent-mask transitions from a face map. */
+constexpr MaskTransitionTable make_upward_table(const int8_t (&map)[2][kNumDigits][kNumFaces + 1]) {
+    MaskTransitionTable t;
+    for (int parity = 0; parity < 2; ++parity) {
+        for (int digit = 0; digit < kNumDigits; ++digit) {
+            for (int mask = 0; mask < kNumMasks; ++mask) {
+                uint8_t out = 0;
+                for (int face = 1; face <= kNumFaces; ++face) {
+                    int parent_face = map[parity][digit][face];
+                    if ((mask & (1 << (face - 1))) && parent_face != 0) {
+                        out |= static_cast<uint8_t>(1 << (parent_face - 1));
+                    }
+                }
+                t.next[parity][digit][mask] = out;
+            }
+        }
+    }
+    return t;
+}
+
+/** Builds parent-mask -> child-mask transitions from a reversed face map. */
+constexpr MaskTransitionTable make_downward_table(const uint8_t (&map)[2][kNumDigits][kNumFaces + 1]) {
+    MaskTransitionTable t;
+    for (int parity = 0; parity < 2; ++parity) {
+        for (int digit = 0; digit < kNumDigits; ++digit) {
+            for (int mask = 0; mask < kNumMasks; ++mask) {
+                uint8_t out = 0;
+                for (int face = 1; face <= kNumFaces; ++face) {
+                    if (mask & (1 << (face - 1))) {
+                        out |= map[parity][digit][face];
+                    }
+                }
+                t.next[parity][digit][mask] = out;
+            }
+        }
+    }
+    return t;
+}
+
+constexpr MaskTransitionTable kHexUpward = make_upward_table(kHexFaceMap);
+constexpr MaskTransitionTable kPentUpward = make_upward_table(kPentFaceMap);
+constexpr MaskTransitionTable kHexDownward = make_downward_table(kReversedHexFaceMap);
+
+/**
+ * Boundary child counts: [parity][depth][mask] -> number of descendants
+ * 'depth' levels below a cell whose own faces 'mask' lie on the boundary,
+ * where parity is that of the first child level. Each level is one
+ * multiplication by the per-parity transfer matrix of kHexDownward (digits
+ * 1-6), unrolled here into a table so a count is a single lookup.
+ *
+ * Hexagon parents only; a pentagon parent subtracts its missing digit-1
+ * branch (see count_children_on_boundary_faces).
+ */
+struct BoundaryCountTable {
+    uint64_t count[2][16][kNumMasks] = {};
+};
+
+constexpr BoundaryCountTable make_boundary_count_table() {
+    BoundaryCountTable t;
+    for (int parity = 0; parity < 2; ++parity) {
+        for (int mask = 1; mask < kNumMasks; ++mask) {
+            t.count[parity][0][mask] = 1;
+        }
+    }
+    for (int depth = 1; depth < 16; ++depth) {
+        for (int parity = 0; parity < 2; ++parity) {
+            for (int mask = 0; mask < kNumMasks; ++mask) {
+                uint64_t total = 0;
+                for (int digit = 1; digit <= 6; ++digit) {
+                    total += t.count[parity ^ 1][depth - 1][kHexDownward.next[parity][digit][mask]];
+                }
+                t.count[parity][depth][mask] = total;
+            }
+        }
+    }
+    return t;
+}
+
+constexpr BoundaryCountTable kBoundaryCount = make_boundary_count_table();
+
+/**
+ * Faces in counter-clockwise order around a cell, and each face's position
+ * in it. The outer child with digit d covers the corner where its parent's
+ * face d begins, so the outer children come in the same order.
+ */
+constexpr int kPerimeterCycle[kNumFaces] = {4, 6, 2, 3, 1, 5};
+constexpr int kPerimeterPos[kNumFaces + 1] = {-1, 4, 2, 3, 0, 5, 1};
+
+/**
+ * Cycle position of the first face of the arc of faces in mask (the one
+ * whose predecessor is missing), or that of face 4 if mask has every face.
+ */
+constexpr int arc_start_pos(uint8_t mask) {
+    for (int p = 0; p < kNumFaces; ++p) {
+        int face = kPerimeterCycle[p];
+        int pred = kPerimeterCycle[(p + kNumFaces - 1) % kNumFaces];
+        if (((mask >> (face - 1)) & 1) && !((mask >> (pred - 1)) & 1)) {
+            return p;
+        }
+    }
+    return kPerimeterPos[4];
+}
+
+/**
+ * [parity][face] -> H3 direction digit of the neighbor across that face, for
+ * a cell whose resolution has that parity. Faces are the H3 directions at
+ * odd (Class III) resolutions and one step counter-clockwise at even ones.
+ */
+constexpr int8_t kFaceDirection[2][kNumFaces + 1] = {
+    {0, 5, 3, 1, 6, 4, 2},
+    {0, 1, 2, 3, 4, 5, 6},
+};
+
+// ---------------------------------------------------------------------------
+// H3 index bit helpers
+//
+// Layout: mode (4 bits) | reserved (3) | res (4) | base cell (7) | 15 digits (3 each)
+// ---------------------------------------------------------------------------
+
+constexpr int kModeOffset = 59;
+constexpr uint64_t kModeMask = UINT64_C(0xF) << kModeOffset;
+constexpr uint64_t kCellMode = 1;
+constexpr uint64_t kDirectedEdgeMode = 2;
+constexpr int kReservedOffset = 56;
+constexpr int kResOffset = 52;
+constexpr uint64_t kResMask = UINT64_C(0xF) << kResOffset;
+constexpr int kBaseCellOffset = 45;
+constexpr uint64_t kBaseCellMask = UINT64_C(0x7F) << kBaseCellOffset;
+constexpr int kNumBaseCells = 122;
+
+constexpr int digit_offset(int res) {
+    return (15 - res) * 3;
+}
+
+constexpr int get_digit(H3Index h, int res) {
+    return static_cast<int>((h >> digit_offset(res)) & 0x7);
+}
+
+constexpr int get_index_res(H3Index h) {
+    return static_cast<int>((h & kResMask) >> kResOffset);
+}
+
+/** Ancestor of h at res_parent, computed by masking the index in place. */
+constexpr H3Index index_to_parent(H3Index h, int res_parent) {
+    H3Index unused = (UINT64_C(1) << digit_offset(res_parent)) - 1;
+    return (h & ~kResMask & ~unused) | (static_cast<uint64_t>(res_parent) << kResOffset) | unused;
+}
+
+/** True if digits 1..res of h are all zero (the center-child chain). */
+constexpr bool leading_digits_zero(H3Index h, int res) {
+    if (res <= 0) {
+        return true;
+    }
+    uint64_t bits = (UINT64_C(1) << (res * 3)) - 1;
+    return ((h >> digit_offset(res)) & bits) == 0;
+}
+
+constexpr int get_base_cell(H3Index h) {
+    return static_cast<int>((h & kBaseCellMask) >> kBaseCellOffset);
+}
+
+/**
+ * Cheap structural check used by the batch entry points: cell mode, reserved
+ * high bit clear and a base cell in range. Does not walk the digits the way
+ * isValidCell does.
+ */
+constexpr bool has_cell_header(H3Index h) {
+    return (h >> 63) == 0 && ((h & kModeMask) >> kModeOffset) == kCellMode &&
+           get_base_cell(h) < kNumBaseCells;
+}
+
+/** Bitmap of the 12 pentagon base cells (4, 14, 24, 38, 49, 58, 63, 72, 83, 97, 107, 117). */
+constexpr uint64_t kPentagonBaseCellsLo =
+    (UINT64_C(1) << 4) | (UINT64_C(1) << 14) | (UINT64_C(1) << 24) | (UINT64_C(1) << 38) |
+    (UINT64_C(1) << 49) | (UINT64_C(1) << 58) | (UINT64_C(1) << 63);
+constexpr uint64_t kPentagonBaseCellsHi =
+    (UINT64_C(1) << (72 - 64)) | (UINT64_C(1) << (83 - 64)) | (UINT64_C(1) << (97 - 64)) |
+    (UINT64_C(1) << (107 - 64)) | (UINT64_C(1) << (117 - 64));
+
+/** True if the base cell of h is one of the 12 pentagons. */
+constexpr bool is_pentagon_base_cell(H3Index h) {
+    int bc = get_base_cell(h);
+    return bc < 64 ? ((kPentagonBaseCellsLo >> bc) & 1) != 0
+                   : ((kPentagonBaseCellsHi >> (bc - 64)) & 1) != 0;
+}
+
+/**
+ * For a cell on a pentagon base cell, the resolution whose parent is the
+ * pentagon (the first non-zero digit), or 0 if every digit is zero.
+ */
+constexpr int pentagon_parent_level(H3Index h, int h_res) {
+    for (int res = 1; res <= h_res; ++res) {
+        if (get_digit(h, res) != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Composite transition table consuming Stride consecutive digits per lookup:
+ * [parity of the finest level][digit tuple][mask] -> mask. The tuple is the
+ * 3 * Stride index bits starting at the finest digit, so the finest digit
+ * sits in the low 3 bits exactly as it is laid out in the index.
+ *
+ * Size is 2 * 8^Stride * 64 bytes: 8 KiB for Stride 2, 64 KiB for 3, 512 KiB
+ * for 4.
+ */
+template <int Stride>
+struct CompositeTransitionTable {
+    static constexpr int kStride = Stride;
+    static constexpr uint64_t kTupleMask = (UINT64_C(1) << (3 * Stride)) - 1;
+    uint8_t next[2][1 << (3 * Stride)][kNumMasks] = {};
+    uint8_t gather_padding[8] = {};  // lets 8-byte vector gathers read the last entry
+};
+
+/** Composes Stride levels of a single-level table into one lookup. */
+template <int Stride>
+constexpr CompositeTransitionTable<Stride> make_composite_table(const MaskTransitionTable& single) {
+    CompositeTransitionTable<Stride> t;
+    for (int parity = 0; parity < 2; ++parity) {
+        for (int tuple = 0; tuple < (1 << (3 * Stride)); ++tuple) {
+            for (int mask = 0; mask < kNumMasks; ++mask) {
+                uint8_t m = static_cast<uint8_t>(mask);
+                for (int level = 0; level < Stride; ++level) {
+                    int digit = (tuple >> (3 * level)) & 0x7;
+                    m = single.next[(parity + level) & 1][digit][m];
+                }
+                t.next[parity][tuple][mask] = m;
+            }
+        }
+    }
+    return t;
+}
+
+/**
+ * Levels consumed per lookup by the tracers. Stride 3 turns a res 15 -> 0
+ * trace into 5 lookups through a 64 KiB table; bench_face_tables reports the
+ * trade-off for strides 1-4 (stride 4 still needs 6 lookups for 15 levels,
+ * three runs plus three single levels, from a 512 KiB table).
+ */
+constexpr int kTraceStride = 3;
+constexpr CompositeTransitionTable<kTraceStride> kHexUpwardComposite = make_composite_table<kTraceStride>(kHexUpward);
+
+/**
+ * Upward trace consuming Stride levels per lookup. The level whose parent is
+ * a pentagon, and any remainder above res_parent, fall back to single-level
+ * steps.
+ */
+template <int Stride>
+inline uint8_t trace_mask_upward_strided(H3Index h, int h_res, int res_parent, uint8_t mask,
+                                         const CompositeTransitionTable<Stride>& composite) {
+    int pent_level = is_pentagon_base_cell(h) ? pentagon_parent_level(h, h_res) : -1;
+    int res = h_res;
+    while (res > res_parent && mask != 0) {
+        int bottom = res - Stride;
+        if (bottom >= res_parent && (pent_level <= bottom || pent_level > res)) {
+            mask = composite.next[res & 1][(h >> digit_offset(res)) & composite.kTupleMask][mask];
+            res = bottom;
+        } else {
+            const auto& table = (res == pent_level) ? kPentUpward : kHexUpward;
+            mask = table.next[res & 1][get_digit(h, res)][mask];
+            --res;
+        }
+    }
+    return mask;
+}
+
+/**
+ * Core upward trace on a raw mask, shared by the single-cell and batch entry
+ * points. Arguments must already be validated.
+ *
+ * Only the level whose parent is a pentagon needs the pentagon table: above
+ * it every digit is zero, which the zero rows of either table map to 0.
+ */
+inline uint8_t trace_mask_upward(H3Index h, int h_res, int res_parent, uint8_t mask) {
+    return trace_mask_upward_strided(h, h_res, res_parent, mask, kHexUpwardComposite);
+}
+
+/**
+ * Single upward pass for cell_to_coarsest_ancestor_on_faces: resolution of
+ * the coarsest ancestor of h whose boundary faces still intersect mask, i.e.
+ * the level at which the running mask first becomes empty (h_res if it is
+ * empty to begin with, 0 if it never empties).
+ */
+inline int coarsest_ancestor_res(H3Index h, int h_res, uint8_t mask) {
+    int pent_level = is_pentagon_base_cell(h) ? pentagon_parent_level(h, h_res) : -1;
+    int res = h_res;
+    while (res > 0) {
+        int bottom = res - kTraceStride;
+        if (bottom >= 0 && (pent_level <= bottom || pent_level > res)) {
+            // Skip whole runs the mask survives; a run that empties it is
+            // replayed level by level to find the exact resolution.
+            uint8_t next = kHexUpwardComposite.next[res & 1][(h >> digit_offset(res)) & kHexUpwardComposite.kTupleMask][mask];
+            if (next != 0) {
+                mask = next;
+                res = bottom;
+                continue;
+            }
+        }
+        const auto& table = (res == pent_level) ? kPentUpward : kHexUpward;
+        mask = table.next[res & 1][get_digit(h, res)][mask];
+        if (mask == 0) {
+            return res;
+        }
+        --res;
+    }
+    return 0;
+}
+
+} // namespace detail
+} // namespace h3_toolkit
@@ -0,0 +1,474 @@
+/**
+ * @file face_trace_batch.cpp
+ * @brief Column-at-a-time face tracing over contiguous arrays of H3 cells.
+ *
+ * These entry points are meant for tight loops over millions of cells: they
+ * never throw and never allocate; per-element failures are reported through
+ * a parallel status array instead.
+ *
+ * On x86-64 the work is done by AVX2 or AVX-512 kernels when the CPU has
+ * them, selected once at runtime so a single binary runs everywhere. The
+ * vector kernels process one resolution level for 4 (AVX2) or 8 (AVX-512)
+ * cells at a time: a uniform shift extracts the digit of every lane, and a
+ * gather does the table lookup.
+ */
+
+#include "h3_toolkit.hpp"
+#include "face_tables.hpp"
+#include <atomic>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define H3_TOOLKIT_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace h3_toolkit {
+
+namespace {
+
+/**
+ * Arguments shared by every kernel. A stride of 0 broadcasts the first
+ * element of masks / res_parents to all cells.
+ */
+struct TraceArgs {
+    const H3Index* cells;
+    size_t count;
+    const FaceMask* masks;
+    size_t mask_stride;
+    const int* res_parents;
+    size_t res_stride;
+    FaceMask* out_faces;
+    H3Error* out_status;
+};
+
+inline H3Error trace_one(H3Index h, uint8_t mask, int res_parent, FaceMask* out) {
+    if (!detail::has_cell_header(h)) {
+        *out = FaceMask::None;
+        return E_CELL_INVALID;
+    }
+    int h_res = detail::get_index_res(h);
+    if (res_parent < 0 || res_parent >= h_res) {
+        *out = FaceMask::None;
+        return E_RES_DOMAIN;
+    }
+    *out = static_cast<FaceMask>(detail::trace_mask_upward(h, h_res, res_parent, mask));
+    return E_SUCCESS;
+}
+
+void trace_scalar_from(const TraceArgs& a, size_t begin) {
+    for (size_t i = begin; i < a.count; ++i) {
+        uint8_t mask = static_cast<uint8_t>(a.masks[i * a.mask_stride]) & detail::kAllFacesMask;
+        H3Error err = trace_one(a.cells[i], mask, a.res_parents[i * a.res_stride], &a.out_faces[i]);
+        if (a.out_status) {
+            a.out_status[i] = err;
+        }
+    }
+}
+
+void trace_scalar(const TraceArgs& a) {
+    trace_scalar_from(a, 0);
+}
+
+#ifdef H3_TOOLKIT_X86_DISPATCH
+
+/**
+ * Upward tables flattened for gathers: [pentagon parent][parity][digit][mask].
+ * Padded so an 8-byte gather at the last entry stays in bounds.
+ */
+struct GatherTable {
+    alignas(64) uint8_t v[2 * 2 * detail::kNumDigits * detail::kNumMasks + 8] = {};
+};
+
+constexpr GatherTable make_gather_table() {
+    GatherTable t;
+    for (int parity = 0; parity < 2; ++parity) {
+        for (int digit = 0; digit < detail::kNumDigits; ++digit) {
+            for (int mask = 0; mask < detail::kNumMasks; ++mask) {
+                int idx = (parity * detail::kNumDigits + digit) * detail::kNumMasks + mask;
+                t.v[idx] = detail::kHexUpward.next[parity][digit][mask];
+                t.v[1024 + idx] = detail::kPentUpward.next[parity][digit][mask];
+            }
+        }
+    }
+    return t;
+}
+
+constexpr GatherTable kGatherTable = make_gather_table();
+
+/** Distance between the two parity halves of kHexUpwardComposite. */
+constexpr int kCompositeParityStride = (1 << (3 * detail::kTraceStride)) * detail::kNumMasks;
+
+/** Bits covering digits 1..res of an index (0 for res 0). */
+constexpr uint64_t leading_digit_bits(int res) {
+    return (UINT64_C(1) << (res * 3)) - 1;
+}
+
+inline H3Error lane_status(bool header_ok, bool res_ok) {
+    return !header_ok ? E_CELL_INVALID : (!res_ok ? E_RES_DOMAIN : E_SUCCESS);
+}
+
+/** State of 4 cells being traced together by the AVX2 kernel. */
+struct Avx2Lanes {
+    __m256i h, mask, rp, h_res, pent_bc, header_ok, res_ok;
+};
+
+__attribute__((target("avx2"), always_inline))
+inline Avx2Lanes avx2_load(const TraceArgs& a, size_t i) {
+    const __m256i one = _mm256_set1_epi64x(1);
+    Avx2Lanes l;
+    l.h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.cells + i));
+    if (a.mask_stride) {
+        int32_t packed;
+        __builtin_memcpy(&packed, a.masks + i, 4);
+        l.mask = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+    } else {
+        l.mask = _mm256_set1_epi64x(static_cast<uint8_t>(a.masks[0]));
+    }
+    if (a.res_stride) {
+        l.rp = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.res_parents + i)));
+    } else {
+        l.rp = _mm256_set1_epi64x(a.res_parents[0]);
+    }
+
+    l.h_res = _mm256_and_si256(_mm256_srli_epi64(l.h, detail::kResOffset), _mm256_set1_epi64x(0xF));
+    __m256i bc = _mm256_and_si256(_mm256_srli_epi64(l.h, detail::kBaseCellOffset), _mm256_set1_epi64x(0x7F));
+    l.header_ok = _mm256_and_si256(
+        _mm256_cmpeq_epi64(_mm256_srli_epi64(l.h, detail::kModeOffset), _mm256_set1_epi64x(detail::kCellMode)),
+        _mm256_cmpgt_epi64(_mm256_set1_epi64x(detail::kNumBaseCells), bc));
+    l.res_ok = _mm256_and_si256(_mm256_cmpgt_epi64(l.h_res, l.rp), _mm256_cmpgt_epi64(l.rp, _mm256_set1_epi64x(-1)));
+    l.mask = _mm256_and_si256(l.mask, _mm256_set1_epi64x(detail::kAllFacesMask));
+    l.mask = _mm256_and_si256(l.mask, _mm256_and_si256(l.header_ok, l.res_ok));
+
+    // Shift counts >= 64 give 0, so each half of the bitmap only answers for its own range
+    __m256i pent_bits = _mm256_or_si256(
+        _mm256_srlv_epi64(_mm256_set1_epi64x(static_cast<long long>(detail::kPentagonBaseCellsLo)), bc),
+        _mm256_srlv_epi64(_mm256_set1_epi64x(static_cast<long long>(detail::kPentagonBaseCellsHi)),
+                          _mm256_sub_epi64(bc, _mm256_set1_epi64x(64))));
+    l.pent_bc = _mm256_cmpeq_epi64(_mm256_and_si256(pent_bits, one), one);
+    return l;
+}
+
+/** One resolution level for 4 cells: digit extraction, gather, blend. */
+__attribute__((target("avx2"), always_inline))
+inline void avx2_step(Avx2Lanes& l, int res, bool any_pent) {
+    const long long* table = reinterpret_cast<const long long*>(kGatherTable.v);
+    __m256i active = _mm256_and_si256(_mm256_cmpgt_epi64(l.h_res, _mm256_set1_epi64x(res - 1)),
+                                      _mm256_cmpgt_epi64(_mm256_set1_epi64x(res), l.rp));
+    __m256i digit = _mm256_and_si256(_mm256_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res))),
+                                     _mm256_set1_epi64x(0x7));
+    __m256i idx = _mm256_add_epi64(_mm256_set1_epi64x((res & 1) * 512),
+                                   _mm256_add_epi64(_mm256_slli_epi64(digit, 6), l.mask));
+    if (any_pent) {
+        // The parent is a pentagon iff the base cell is one and digits 1..res-1 are zero
+        __m256i above = _mm256_and_si256(
+            _mm256_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res - 1))),
+            _mm256_set1_epi64x(static_cast<long long>(leading_digit_bits(res - 1))));
+        __m256i pent = _mm256_and_si256(l.pent_bc, _mm256_cmpeq_epi64(above, _mm256_setzero_si256()));
+        idx = _mm256_add_epi64(idx, _mm256_and_si256(pent, _mm256_set1_epi64x(1024)));
+    }
+    __m256i next = _mm256_and_si256(_mm256_i64gather_epi64(table, idx, 1), _mm256_set1_epi64x(0xFF));
+    l.mask = _mm256_blendv_epi8(l.mask, next, active);
+}
+
+/** kTraceStride levels for 4 cells that are all active over the whole run. */
+__attribute__((target("avx2"), always_inline))
+inline void avx2_composite_step(Avx2Lanes& l, int res) {
+    const long long* table = reinterpret_cast<const long long*>(detail::kHexUpwardComposite.next);
+    __m256i tuple = _mm256_and_si256(_mm256_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res))),
+                                     _mm256_set1_epi64x(static_cast<long long>(detail::kHexUpwardComposite.kTupleMask)));
+    __m256i idx = _mm256_add_epi64(_mm256_set1_epi64x((res & 1) * kCompositeParityStride),
+                                   _mm256_add_epi64(_mm256_slli_epi64(tuple, 6), l.mask));
+    l.mask = _mm256_and_si256(_mm256_i64gather_epi64(table, idx, 1), _mm256_set1_epi64x(0xFF));
+}
+
+/** True if all 8 lanes share lane 0's resolution and res_parent (returned via top/bottom). */
+__attribute__((target("avx2"), always_inline))
+inline bool avx2_uniform(const Avx2Lanes& x, const Avx2Lanes& y, int* top, int* bottom) {
+    __m256i r0 = _mm256_permute4x64_epi64(x.h_res, 0);
+    __m256i p0 = _mm256_permute4x64_epi64(x.rp, 0);
+    __m256i eq = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi64(x.h_res, r0), _mm256_cmpeq_epi64(y.h_res, r0)),
+                                  _mm256_and_si256(_mm256_cmpeq_epi64(x.rp, p0), _mm256_cmpeq_epi64(y.rp, p0)));
+    *top = static_cast<int>(_mm_cvtsi128_si64(_mm256_castsi256_si128(r0)));
+    *bottom = static_cast<int>(_mm_cvtsi128_si64(_mm256_castsi256_si128(p0)));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(eq)) == 0xF;
+}
+
+__attribute__((target("avx2"), always_inline))
+inline void avx2_store(const TraceArgs& a, size_t i, const Avx2Lanes& l) {
+    alignas(32) uint64_t out[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(out), l.mask);
+    int header_bits = _mm256_movemask_pd(_mm256_castsi256_pd(l.header_ok));
+    int res_bits = _mm256_movemask_pd(_mm256_castsi256_pd(l.res_ok));
+    for (int lane = 0; lane < 4; ++lane) {
+        a.out_faces[i + lane] = static_cast<FaceMask>(out[lane]);
+        if (a.out_status) {
+            a.out_status[i + lane] = lane_status((header_bits >> lane) & 1, (res_bits >> lane) & 1);
+        }
+    }
+}
+
+/**
+ * Two independent groups of 4 cells per iteration, so one group's gather
+ * latency overlaps the other's arithmetic.
+ */
+__attribute__((target("avx2")))
+void trace_avx2(const TraceArgs& a) {
+    size_t i = 0;
+    for (; i + 8 <= a.count; i += 8) {
+        Avx2Lanes x = avx2_load(a, i);
+        Avx2Lanes y = avx2_load(a, i + 4);
+        bool any_pent = !_mm256_testz_si256(_mm256_or_si256(x.pent_bc, y.pent_bc),
+                                            _mm256_or_si256(x.pent_bc, y.pent_bc));
+        int top, bottom;
+        if (!any_pent && avx2_uniform(x, y, &top, &bottom)) {
+            // Common column case: every lane climbs the same levels, so whole
+            // digit runs go through the composite table with no blending.
+            int res = top;
+            for (; res - detail::kTraceStride >= bottom; res -= detail::kTraceStride) {
+                __m256i live = _mm256_or_si256(x.mask, y.mask);
+                if (_mm256_testz_si256(live, live)) {
+                    break;
+                }
+                avx2_composite_step(x, res);
+                avx2_composite_step(y, res);
+            }
+            for (; res > bottom && res >= 1; --res) {
+                avx2_step(x, res, false);
+                avx2_step(y, res, false);
+            }
+        } else {
+            for (int res = 15; res >= 1; --res) {
+                __m256i live = _mm256_or_si256(x.mask, y.mask);
+                if (_mm256_testz_si256(live, live)) {
+                    break;
+                }
+                avx2_step(x, res, any_pent);
+                avx2_step(y, res, any_pent);
+            }
+        }
+        avx2_store(a, i, x);
+        avx2_store(a, i + 4, y);
+    }
+    trace_scalar_from(a, i);
+}
+
+/** State of 8 cells being traced together by the AVX-512 kernel. */
+struct Avx512Lanes {
+    __m512i h, mask, rp, h_res;
+    __mmask8 pent_bc, header_ok, res_ok;
+};
+
+__attribute__((target("avx512f"), always_inline))
+inline Avx512Lanes avx512_load(const TraceArgs& a, size_t i) {
+    Avx512Lanes l;
+    l.h = _mm512_loadu_si512(a.cells + i);
+    if (a.mask_stride) {
+        l.mask = _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a.masks + i)));
+    } else {
+        l.mask = _mm512_set1_epi64(static_cast<uint8_t>(a.masks[0]));
+    }
+    if (a.res_stride) {
+        l.rp = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.res_parents + i)));
+    } else {
+        l.rp = _mm512_set1_epi64(a.res_parents[0]);
+    }
+
+    l.h_res = _mm512_and_si512(_mm512_srli_epi64(l.h, detail::kResOffset), _mm512_set1_epi64(0xF));
+    __m512i bc = _mm512_and_si512(_mm512_srli_epi64(l.h, detail::kBaseCellOffset), _mm512_set1_epi64(0x7F));
+    l.header_ok =
+        _mm512_cmpeq_epi64_mask(_mm512_srli_epi64(l.h, detail::kModeOffset), _mm512_set1_epi64(detail::kCellMode)) &
+        _mm512_cmplt_epi64_mask(bc, _mm512_set1_epi64(detail::kNumBaseCells));
+    l.res_ok = _mm512_cmpgt_epi64_mask(l.h_res, l.rp) & _mm512_cmpge_epi64_mask(l.rp, _mm512_setzero_si512());
+    l.mask = _mm512_maskz_and_epi64(l.header_ok & l.res_ok, l.mask, _mm512_set1_epi64(detail::kAllFacesMask));
+
+    __m512i pent_bits = _mm512_or_si512(
+        _mm512_srlv_epi64(_mm512_set1_epi64(static_cast<long long>(detail::kPentagonBaseCellsLo)), bc),
+        _mm512_srlv_epi64(_mm512_set1_epi64(static_cast<long long>(detail::kPentagonBaseCellsHi)),
+                          _mm512_sub_epi64(bc, _mm512_set1_epi64(64))));
+    l.pent_bc = _mm512_test_epi64_mask(pent_bits, _mm512_set1_epi64(1));
+    return l;
+}
+
+/** One resolution level for 8 cells; same scheme as avx2_step with mask registers. */
+__attribute__((target("avx512f"), always_inline))
+inline void avx512_step(Avx512Lanes& l, int res, bool any_pent) {
+    const long long* table = reinterpret_cast<const long long*>(kGatherTable.v);
+    __mmask8 active = _mm512_cmple_epi64_mask(_mm512_set1_epi64(res), l.h_res) &
+                      _mm512_cmpgt_epi64_mask(_mm512_set1_epi64(res), l.rp);
+    __m512i digit = _mm512_and_si512(_mm512_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res))),
+                                     _mm512_set1_epi64(0x7));
+    __m512i idx = _mm512_add_epi64(_mm512_set1_epi64((res & 1) * 512),
+                                   _mm512_add_epi64(_mm512_slli_epi64(digit, 6), l.mask));
+    if (any_pent) {
+        __m512i above = _mm512_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res - 1)));
+        __mmask8 pent = l.pent_bc & _mm512_testn_epi64_mask(
+            above, _mm512_set1_epi64(static_cast<long long>(leading_digit_bits(res - 1))));
+        idx = _mm512_mask_add_epi64(idx, pent, idx, _mm512_set1_epi64(1024));
+    }
+    __m512i next = _mm512_and_si512(_mm512_mask_i64gather_epi64(l.mask, active, idx, table, 1),
+                                    _mm512_set1_epi64(0xFF));
+    l.mask = _mm512_mask_mov_epi64(l.mask, active, next);
+}
+
+__attribute__((target("avx512f"), always_inline))
+inline void avx512_composite_step(Avx512Lanes& l, int res) {
+    const long long* table = reinterpret_cast<const long long*>(detail::kHexUpwardComposite.next);
+    __m512i tuple = _mm512_and_si512(_mm512_srl_epi64(l.h, _mm_cvtsi32_si128(detail::digit_offset(res))),
+                                     _mm512_set1_epi64(static_cast<long long>(detail::kHexUpwardComposite.kTupleMask)));
+    __m512i idx = _mm512_add_epi64(_mm512_set1_epi64((res & 1) * kCompositeParityStride),
+                                   _mm512_add_epi64(_mm512_slli_epi64(tuple, 6), l.mask));
+    l.mask = _mm512_and_si512(_mm512_i64gather_epi64(idx, table, 1), _mm512_set1_epi64(0xFF));
+}
+
+__attribute__((target("avx512f"), always_inline))
+inline bool avx512_uniform(const Avx512Lanes& x, const Avx512Lanes& y, int* top, int* bottom) {
+    *top = static_cast<int>(_mm_cvtsi128_si64(_mm512_castsi512_si128(x.h_res)));
+    *bottom = static_cast<int>(_mm_cvtsi128_si64(_mm512_castsi512_si128(x.rp)));
+    __m512i r0 = _mm512_set1_epi64(*top);
+    __m512i p0 = _mm512_set1_epi64(*bottom);
+    return (_mm512_cmpeq_epi64_mask(x.h_res, r0) & _mm512_cmpeq_epi64_mask(y.h_res, r0) &
+            _mm512_cmpeq_epi64_mask(x.rp, p0) & _mm512_cmpeq_epi64_mask(y.rp, p0)) == 0xFF;
+}
+
+__attribute__((target("avx512f"), always_inline))
+inline void avx512_store(const TraceArgs& a, size_t i, const Avx512Lanes& l) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(a.out_faces + i), _mm512_cvtepi64_epi8(l.mask));
+    if (a.out_status) {
+        for (int lane = 0; lane < 8; ++lane) {
+            a.out_status[i + lane] = lane_status((l.header_ok >> lane) & 1, (l.res_ok >> lane) & 1);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+void trace_avx512(const TraceArgs& a) {
+    size_t i = 0;
+    for (; i + 16 <= a.count; i += 16) {
+        Avx512Lanes x = avx512_load(a, i);
+        Avx512Lanes y = avx512_load(a, i + 8);
+        bool any_pent = (x.pent_bc | y.pent_bc) != 0;
+        int top, bottom;
+        if (!any_pent && avx512_uniform(x, y, &top, &bottom)) {
+            int res = top;
+            for (; res - detail::kTraceStride >= bottom; res -= detail::kTraceStride) {
+                if ((_mm512_test_epi64_mask(x.mask, x.mask) | _mm512_test_epi64_mask(y.mask, y.mask)) == 0) {
+                    break;
+                }
+                avx512_composite_step(x, res);
+                avx512_composite_step(y, res);
+            }
+            for (; res > bottom && res >= 1; --res) {
+                avx512_step(x, res, false);
+                avx512_step(y, res, false);
+            }
+        } else {
+            for (int res = 15; res >= 1; --res) {
+                if ((_mm512_test_epi64_mask(x.mask, x.mask) | _mm512_test_epi64_mask(y.mask, y.mask)) == 0) {
+                    break;
+                }
+                avx512_step(x, res, any_pent);
+                avx512_step(y, res, any_pent);
+            }
+        }
+        avx512_store(a, i, x);
+        avx512_store(a, i + 8, y);
+    }
+    trace_scalar_from(a, i);
+}
+
+#endif // H3_TOOLKIT_X86_DISPATCH
+
+using TraceKernel = void (*)(const TraceArgs&);
+
+TraceKernel kernel_for(SimdLevel level) {
+#ifdef H3_TOOLKIT_X86_DISPATCH
+    switch (level) {
+        case SimdLevel::AVX512: return trace_avx512;
+        case SimdLevel::AVX2: return trace_avx2;
+        case SimdLevel::Scalar: break;
+    }
+#else
+    (void)level;
+#endif
+    return trace_scalar;
+}
+
+SimdLevel detect() {
+#ifdef H3_TOOLKIT_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+std::atomic<SimdLevel>& selected_level() {
+    static std::atomic<SimdLevel> level{detect()};
+    return level;
+}
+
+void run(const TraceArgs& args) {
+    kernel_for(selected_level().load(std::memory_order_relaxed))(args);
+}
+
+} // namespace
+
+SimdLevel detected_simd_level() noexcept {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+SimdLevel active_simd_level() noexcept {
+    return selected_level().load(std::memory_order_relaxed);
+}
+
+SimdLevel set_simd_level(SimdLevel level) noexcept {
+    if (static_cast<int>(level) > static_cast<int>(detected_simd_level())) {
+        level = detected_simd_level();
+    }
+    selected_level().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+void trace_cells_to_ancestor_faces(const H3Index* cells, size_t count, FaceMask input_faces,
+                                   int res_parent, FaceMask* out_faces, H3Error* out_status) noexcept {
+    run({cells, count, &input_faces, 0, &res_parent, 0, out_faces, out_status});
+}
+
+void trace_cells_to_ancestor_faces(const H3Index* cells, size_t count, const FaceMask* input_faces,
+                                   const int* res_parents, FaceMask* out_faces, H3Error* out_status) noexcept {
+    run({cells, count, input_faces, 1, res_parents, 1, out_faces, out_status});
+}
+
+void cells_to_coarsest_ancestors_on_faces(const H3Index* cells, size_t count, FaceMask input_faces,
+                                          H3Index* out_ancestors, int* out_res, H3Error* out_status) noexcept {
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    for (size_t i = 0; i < count; ++i) {
+        H3Index h = cells[i];
+        H3Error err = E_SUCCESS;
+        H3Index ancestor = H3_NULL;
+        int res = -1;
+        if (detail::has_cell_header(h)) {
+            int h_res = detail::get_index_res(h);
+            res = detail::coarsest_ancestor_res(h, h_res, mask);
+            ancestor = detail::index_to_parent(h, res);
+        } else {
+            err = E_CELL_INVALID;
+        }
+        if (out_ancestors) {
+            out_ancestors[i] = ancestor;
+        }
+        if (out_res) {
+            out_res[i] = res;
+        }
+        if (out_status) {
+            out_status[i] = err;
+        }
+    }
+}
+
+} // namespace h3_toolkit
@@ -21,10 +21,18 @@
  */
 
 #include "h3_toolkit.hpp"
-#include <map>
+#include "convex_offset.hpp"
+#include "face_tables.hpp"
+#include "overhang_table.hpp"
+#include "polygon_cache.hpp"
+#include "thread_pool.hpp"
 #include <stdexcept>
-#include <functional>
 #include <cmath>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
 
 // Boost.Geometry for polygon buffering and union operations
 #include <boost/geometry.hpp>
@@ -38,63 +46,37 @@ namespace bg = boost::geometry;
 
 namespace h3_toolkit {
 
-/**
- * Face mapping tables for hexagonal cells.
- * 
- * These tables encode how child cell faces map to parent cell faces
- * based on resolution parity (even/odd) and child position (1-6).
- * Position 0 is the center child and doesn't touch any parent face.
- * 
- * Structure: parity -> child_pos -> {child_face -> parent_face}
- */
+// Face mapping tables live in face_tables.hpp as constexpr dense arrays:
+// [parity][child_pos][face] maps plus the [parity][child_pos][mask] -> mask
+// transition tables derived from them at compile time.
 
-// Map structure: parity -> child_pos -> {child_face -> parent_face}
-// Using simple logic since strict standard maps are bulky to initialize in C++98/03 style, 
-// constructing them inside a function or static initializer is safer.
-
-static const std::map<int, std::map<int, std::map<int, int>>>& get_hex_mapping() {
-    static std::map<int, std::map<int, std::map<int, int>>> m;
-    if (m.empty()) {
-        // Even resolutions (parity 0)
-        m[0][1] = {{2, 3}, {3, 1}, {1, 1}};
-        m[0][2] = {{4, 6}, {2, 2}, {6, 2}};
-        m[0][3] = {{6, 2}, {2, 3}, {3, 3}};
-        m[0][4] = {{1, 5}, {4, 4}, {5, 4}};
-        m[0][5] = {{1, 5}, {3, 1}, {5, 5}};
-        m[0][6] = {{4, 6}, {5, 4}, {6, 6}};
-
-        // Odd resolutions (parity 1)
-        m[1][1] = {{3, 3}, {1, 3}, {5, 1}};
-        m[1][2] = {{2, 6}, {6, 6}, {3, 2}};
-        m[1][3] = {{2, 2}, {1, 3}, {3, 2}};
-        m[1][4] = {{4, 5}, {5, 5}, {6, 4}};
-        m[1][5] = {{1, 1}, {4, 5}, {5, 1}};
-        m[1][6] = {{4, 4}, {2, 6}, {6, 4}};
-    }
-    return m;
-}
-
-static const std::map<int, std::map<int, std::map<int, int>>>& get_pent_mapping() {
-    static std::map<int, std::map<int, std::map<int, int>>> m;
-    if (m.empty()) {
-        // Even resolutions
-        m[0][1] = {{4, 5}, {2, 1}, {6, 1}};
-        m[0][2] = {{6, 1}, {3, 2}, {2, 2}};
-        m[0][3] = {{5, 2}, {4, 2}, {6, 4}};
-        m[0][4] = {{3, 2}, {5, 4}, {1, 2}};
-        m[0][5] = {{5, 3}, {6, 5}, {4, 5}};
-
-        // Odd resolutions
-        m[1][1] = {{2, 5}, {6, 5}, {3, 1}};
-        m[1][2] = {{3, 1}, {2, 1}, {1, 2}};
-        m[1][3] = {{1, 4}, {4, 3}, {5, 3}};
-        m[1][4] = {{1, 2}, {5, 2}, {4, 4}};
-        m[1][5] = {{2, 5}, {4, 3}, {6, 3}};
-    }
-    return m;
+int face_count(FaceMask mask) {
+    int count = 0;
+    for (uint8_t bits = static_cast<uint8_t>(mask); bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
 }
 
-std::set<int> trace_cell_to_ancestor_faces(H3Index h, const std::set<int>& input_faces, int res_parent) {
+FaceMask to_face_mask(const std::set<int>& faces) {
+    FaceMask mask = FaceMask::None;
+    for (int f : faces) {
+        mask |= face_bit(f);
+    }
+    return mask;
+}
+
+std::set<int> to_face_set(FaceMask mask) {
+    std::set<int> faces;
+    for (int f = 1; f <= 6; ++f) {
+        if (has_face(mask, f)) {
+            faces.insert(f);
+        }
+    }
+    return faces;
+}
+
+FaceMask trace_cell_to_ancestor_faces(H3Index h, FaceMask input_faces, int res_parent) {
     int h_res = getResolution(h);
     
     if (res_parent >= h_res) {
@@ -103,260 +85,512 @@ std::set<int> trace_cell_to_ancestor_faces(H3Index h, const std::set<int>& input
     if (res_parent < 0) {
         throw std::invalid_argument("res_parent cannot be negative");
     }
-    if (input_faces.empty()) {
-        return {};
-    }
-
-    std::set<int> current_faces = input_faces;
-    H3Index current_h = h;
-
-    for (int res = h_res; res > res_parent; --res) {
-        if (isPentagon(current_h)) {
-             return {};
-        }
 
-        int parity = res % 2;
-        // cellToParent and cellToChildPos
-        // Note: libh3 C API names
-        H3Index parent;
-        cellToParent(current_h, res - 1, &parent);
-        
-        long long child_pos; // 0-6
-        // Not a direct C API function like cellToChildPos? 
-        // Actually cellToChildPos is probably not exposed in standard C API directly in older versions?
-        // Wait, standard H3 C library has `cellToChildPos` in v4? 
-        // Or we might need to derive it if not available.
-        // Let's assume v4 API or we check index digits.
-        // H3 index structure: valid mode (4 bits), res (4 bits), base cell (7 bits), 15 digits (3 bits each).
-        // Since we are traversing standard implementation, we can extract the digit at current resolution.
-        
-        // Manual extraction of digit for resolution `res`:
-        // Digit is bits at ((15 - res) * 3).
-        // Actually, easy way: `current_h` & 7 is NOT correct because it's shifted.
-        // Let's use `h3GetResolution(current_h)` to verify we are at `res`.
-        // The digit at `res` is (current_h >> ((15 - res) * 3)) & 0x7;
-        
-        child_pos = (current_h >> ((15 - res) * 3)) & 0x7;
-
-        if (isPentagon(parent)) {
-            // Logic for pentagon parent
-            // But wait, pentagon don't have 7 children properly indexable by 0-6 in same way?
-            // Actually they do, but index 1 deleted.
-             // We can use the mapping tables.
-        }
-
-        if (child_pos == 0) {
-            return {};
-        }
-
-        const auto& mapping = isPentagon(parent) ? get_pent_mapping() : get_hex_mapping();
-        
-        // Safe access
-        if (mapping.count(parity) && mapping.at(parity).count(child_pos)) {
-            const auto& face_map = mapping.at(parity).at(child_pos);
-            std::set<int> next_faces;
-            for (int f : current_faces) {
-                if (face_map.count(f)) {
-                    next_faces.insert(face_map.at(f));
-                }
-            }
-            if (next_faces.empty()) {
-                return {};
-            }
-            current_faces = next_faces;
-        } else {
-            return {};
-        }
-
-        current_h = parent;
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    if (mask == 0) {
+        return FaceMask::None;
     }
 
-    return current_faces;
+    // The digit at each resolution is the child position (0-6) within the
+    // parent; a center child or a pentagon maps to no parent face.
+    mask = detail::trace_mask_upward(h, h_res, res_parent, mask);
+    return static_cast<FaceMask>(mask);
 }
 
-std::set<int> trace_cell_to_parent_faces(H3Index h, const std::set<int>& input_faces) {
+std::set<int> trace_cell_to_ancestor_faces(H3Index h, const std::set<int>& input_faces, int res_parent) {
+    return to_face_set(trace_cell_to_ancestor_faces(h, to_face_mask(input_faces), res_parent));
+}
+
+FaceMask trace_cell_to_parent_faces(H3Index h, FaceMask input_faces) {
     int res = getResolution(h);
     return trace_cell_to_ancestor_faces(h, input_faces, res - 1);
 }
 
+std::set<int> trace_cell_to_parent_faces(H3Index h, const std::set<int>& input_faces) {
+    return to_face_set(trace_cell_to_parent_faces(h, to_face_mask(input_faces)));
+}
+
+H3Index cell_to_coarsest_ancestor_on_faces(H3Index h, FaceMask input_faces) {
+    // One pass over the digits with a running mask; the ancestor is then
+    // read off the index directly instead of climbing with cellToParent.
+    int h_res = getResolution(h);
+    uint8_t mask = static_cast<uint8_t>(input_faces) & detail::kAllFacesMask;
+    int res = detail::coarsest_ancestor_res(h, h_res, mask);
+    return detail::index_to_parent(h, res);
+}
+
 H3Index cell_to_coarsest_ancestor_on_faces(H3Index h, const std::set<int>& input_faces) {
-    int res = getResolution(h);
-    H3Index current_h = h;
-    std::set<int> current_faces = input_faces;
+    return cell_to_coarsest_ancestor_on_faces(h, to_face_mask(input_faces));
+}
+
+PolygonResult cell_boundary(H3Index cell) {
+    CellBoundary cb;
+    cellToBoundary(cell, &cb);
     
-    while (res > 0) {
-        int parent_res = res - 1;
-        auto boundary_faces = trace_cell_to_ancestor_faces(current_h, current_faces, parent_res);
-        
-        if (boundary_faces.empty()) {
-            return current_h;
-        }
-        
-        H3Index parent;
-        cellToParent(current_h, parent_res, &parent);
-        current_h = parent;
-        current_faces = boundary_faces;
-        res = parent_res;
+    PolygonResult result;
+    if (cb.numVerts == 0) {
+        return result;
     }
-    
-    return current_h;
-}
-
-// Reversed mappings: parity -> child_pos -> {parent_face -> child_faces}
-static const std::map<int, std::map<int, std::map<int, std::set<int>>>>& get_reversed_hex_mapping() {
-    static std::map<int, std::map<int, std::map<int, std::set<int>>>> m;
-    if (m.empty()) {
-        // Even resolutions
-        m[0][1] = {{1, {1, 3}}, {3, {2}}};
-        m[0][2] = {{2, {2, 6}}, {6, {4}}};
-        m[0][3] = {{2, {6}}, {3, {2, 3}}};
-        m[0][4] = {{4, {4, 5}}, {5, {1}}};
-        m[0][5] = {{5, {1, 5}}, {1, {3}}};
-        m[0][6] = {{4, {5}}, {6, {4, 6}}};
-        m[0][0] = {};
-        
-        // Odd resolutions
-        m[1][1] = {{3, {1, 3}}, {1, {5}}};
-        m[1][2] = {{6, {2, 6}}, {2, {3}}};
-        m[1][3] = {{2, {2, 3}}, {3, {1}}};
-        m[1][4] = {{5, {4, 5}}, {4, {6}}};
-        m[1][5] = {{1, {1, 5}}, {5, {4}}};
-        m[1][6] = {{4, {4, 6}}, {6, {2}}};
-        m[1][0] = {};
-    }
-    return m;
-}
-
-std::vector<H3Index> children_on_boundary_faces(H3Index parent, int target_res, const std::set<int>& input_faces) {
-    int res_parent = getResolution(parent);
-    if (target_res <= res_parent) {
-        throw std::invalid_argument("target_res must be greater than parent cell resolution");
+    result.coords.reserve(2 * (cb.numVerts + 1));
+    for (int i = 0; i < cb.numVerts; ++i) {
+        result.add_point(radsToDegs(cb.verts[i].lng), radsToDegs(cb.verts[i].lat));
     }
-    
-    std::vector<H3Index> result;
-    
-    // Recursive helper using lambda
-    std::function<void(H3Index, int, const std::set<int>&)> traverse;
-    traverse = [&](H3Index current, int res, const std::set<int>& faces) {
-        if (res == target_res) {
-            result.push_back(current);
-            return;
+    // Close the ring
+    result.add_point(radsToDegs(cb.verts[0].lng), radsToDegs(cb.verts[0].lat));
+    result.end_ring();
+    result.end_part();
+    return result;
+}
+
+namespace {
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+/**
+ * Appends the parts of a Boost multipolygon to 'result', outer rings then
+ * holes, mapping every point to (lon, lat) with 'to_lonlat'.
+ */
+template <typename ToLonLat>
+void append_parts(const multi_polygon_type& parts, PolygonResult& result, const ToLonLat& to_lonlat) {
+    for (const polygon_type& part : parts) {
+        auto append_ring = [&](const polygon_type::ring_type& ring) {
+            for (const auto& pt : ring) {
+                point_type lonlat = to_lonlat(pt);
+                result.add_point(lonlat.x(), lonlat.y());
+            }
+            result.end_ring();
+        };
+        append_ring(part.outer());
+        for (const auto& hole : part.inners()) {
+            append_ring(hole);
         }
-        
-        int parity = (res + 1) % 2;
-        bool is_pent = isPentagon(current);
-        
-        const auto& reverse_mapping = get_reversed_hex_mapping().at(parity);
-        
-        // Get children
-        int64_t num_children;
-        cellToChildrenSize(current, res + 1, &num_children);
-        std::vector<H3Index> children(num_children);
-        cellToChildren(current, res + 1, children.data());
-        
-        for (H3Index child : children) {
-            if (child == 0) continue;
-            
-            // Extract child position digit
-            int child_pos = (child >> ((15 - (res + 1)) * 3)) & 0x7;
-            
-            if (reverse_mapping.count(child_pos) == 0) continue;
-            
-            const auto& child_mapping = reverse_mapping.at(child_pos);
-            std::set<int> mapped_faces;
-            
-            for (int parent_face : faces) {
-                if (child_mapping.count(parent_face)) {
-                    for (int cf : child_mapping.at(parent_face)) {
-                        mapped_faces.insert(cf);
-                    }
-                }
+        result.end_part();
+    }
+}
+
+PolygonResult to_result(const multi_polygon_type& parts) {
+    PolygonResult result;
+    append_parts(parts, result, [](const point_type& pt) { return pt; });
+    return result;
+}
+
+/**
+ * Traces the outline of a walk's cells along their exterior edges: each
+ * cell's own faces on the parent boundary are one arc of its faces, and the
+ * cells come in perimeter order, so the edges chain end to start and the
+ * ring comes out in a single pass. Returns false if an edge does not start
+ * where the previous one ended.
+ */
+bool trace_outline(const PerimeterChildren& walk, int target_res, polygon_type& outline) {
+    const double kJoinTolerance = 1e-9;  // degrees; res 15 edges are ~5e-6
+    const int8_t* direction = detail::kFaceDirection[target_res & 1];
+    auto& ring = outline.outer();
+    ring.clear();
+    ring.reserve(walk.cells.size() * 3);
+
+    bool have_end = false;
+    double end_lon = 0, end_lat = 0;
+    for (size_t i = 0; i < walk.cells.size(); ++i) {
+        uint8_t own = static_cast<uint8_t>(walk.faces[i]);
+        H3Index edge_base = (walk.cells[i] & ~detail::kModeMask) | (detail::kDirectedEdgeMode << detail::kModeOffset);
+        for (int k = 0, p = detail::arc_start_pos(own); k < detail::kNumFaces; ++k, p = (p + 1) % detail::kNumFaces) {
+            int face = detail::kPerimeterCycle[p];
+            if (!(own & (1 << (face - 1)))) {
+                break;
             }
-            
-            if (!mapped_faces.empty()) {
-                traverse(child, res + 1, mapped_faces);
+            H3Index edge = edge_base | (static_cast<uint64_t>(direction[face]) << detail::kReservedOffset);
+            CellBoundary cb;
+            if (directedEdgeToBoundary(edge, &cb) != E_SUCCESS || cb.numVerts < 2) {
+                return false;
             }
+            double lon = radsToDegs(cb.verts[0].lng);
+            double lat = radsToDegs(cb.verts[0].lat);
+            if (have_end && (std::abs(lon - end_lon) > kJoinTolerance || std::abs(lat - end_lat) > kJoinTolerance)) {
+                return false;
+            }
+            // Each edge contributes all but its last vertex, which the next edge starts from
+            for (int v = 0; v + 1 < cb.numVerts; ++v) {
+                ring.push_back(point_type(radsToDegs(cb.verts[v].lng), radsToDegs(cb.verts[v].lat)));
+            }
+            end_lon = radsToDegs(cb.verts[cb.numVerts - 1].lng);
+            end_lat = radsToDegs(cb.verts[cb.numVerts - 1].lat);
+            have_end = true;
         }
-    };
-    
-    traverse(parent, res_parent, input_faces);
-    return result;
+    }
+    if (ring.size() < 3 || std::abs(ring.front().x() - end_lon) > kJoinTolerance ||
+        std::abs(ring.front().y() - end_lat) > kJoinTolerance) {
+        return false;
+    }
+    ring.push_back(ring.front());
+    // The walk is counter-clockwise; correct() gives Boost's clockwise order
+    bg::correct(outline);
+    return true;
 }
 
-std::vector<std::pair<double, double>> cell_boundary(H3Index cell) {
+/** The cell's boundary as a corrected Boost polygon. */
+polygon_type cell_polygon(H3Index cell) {
     CellBoundary cb;
     cellToBoundary(cell, &cb);
     
-    std::vector<std::pair<double, double>> result;
+    polygon_type cell_poly;
     for (int i = 0; i < cb.numVerts; ++i) {
-        result.emplace_back(radsToDegs(cb.verts[i].lng), radsToDegs(cb.verts[i].lat));
+        double lon = radsToDegs(cb.verts[i].lng);
+        double lat = radsToDegs(cb.verts[i].lat);
+        bg::append(cell_poly.outer(), point_type(lon, lat));
     }
     // Close the ring
     if (cb.numVerts > 0) {
-        result.emplace_back(radsToDegs(cb.verts[0].lng), radsToDegs(cb.verts[0].lat));
+        bg::append(cell_poly.outer(), point_type(
+            radsToDegs(cb.verts[0].lng),
+            radsToDegs(cb.verts[0].lat)
+        ));
+    }
+    bg::correct(cell_poly);
+    return cell_poly;
+}
+
+/**
+ * Union of the cells' hexagons as a cascade: neighbours in the input order
+ * are merged pairwise, then the pairs, and so on, so every union works on
+ * two pieces of similar size instead of folding each cell into one growing
+ * polygon. Cells given in walk order are spatially adjacent, which keeps the
+ * intermediate pieces compact. The merges of each level are independent and
+ * run on the shared thread pool.
+ */
+multi_polygon_type union_cells(const std::vector<H3Index>& cells) {
+    if (cells.empty()) {
+        return multi_polygon_type();
+    }
+    auto& pool = detail::ThreadPool::shared();
+    std::vector<multi_polygon_type> level(cells.size());
+    pool.parallel_for(cells.size(), [&](size_t i) {
+        level[i].push_back(cell_polygon(cells[i]));
+    });
+    while (level.size() > 1) {
+        std::vector<multi_polygon_type> next((level.size() + 1) / 2);
+        pool.parallel_for(next.size(), [&](size_t i) {
+            if (2 * i + 1 < level.size()) {
+                bg::union_(level[2 * i], level[2 * i + 1], next[i]);
+            } else {
+                next[i] = std::move(level[2 * i]);
+            }
+        });
+        level = std::move(next);
+    }
+    return std::move(level[0]);
+}
+
+/**
+ * Polygons of the cells from h3lib's cellsToLinkedMultiPolygon, which joins
+ * cell edges using H3's own topology. Returns false if h3lib reports an
+ * error.
+ */
+bool linked_cells_to_polygons(const std::vector<H3Index>& cells, multi_polygon_type& polygons) {
+    LinkedGeoPolygon linked;
+    if (cellsToLinkedMultiPolygon(cells.data(), static_cast<int>(cells.size()), &linked) != E_SUCCESS) {
+        return false;
+    }
+    polygons.clear();
+    for (LinkedGeoPolygon* poly = &linked; poly != nullptr; poly = poly->next) {
+        if (poly->first == nullptr) {
+            continue;
+        }
+        // The first loop is the outer ring, any others are its holes
+        polygon_type polygon;
+        for (LinkedGeoLoop* loop = poly->first; loop != nullptr; loop = loop->next) {
+            auto* ring = &polygon.outer();
+            if (loop != poly->first) {
+                polygon.inners().emplace_back();
+                ring = &polygon.inners().back();
+            }
+            for (LinkedLatLng* v = loop->first; v != nullptr; v = v->next) {
+                ring->push_back(point_type(radsToDegs(v->vertex.lng), radsToDegs(v->vertex.lat)));
+            }
+            if (!ring->empty()) {
+                ring->push_back(ring->front());
+            }
+        }
+        bg::correct(polygon);
+        polygons.push_back(std::move(polygon));
+    }
+    destroyLinkedMultiPolygon(&linked);
+    return true;
+}
+
+multi_polygon_type cells_to_multi_polygon(const std::vector<H3Index>& cells, OutlineBackend backend) {
+    multi_polygon_type polygons;
+    if (backend == OutlineBackend::H3 && linked_cells_to_polygons(cells, polygons)) {
+        return polygons;
     }
+    return union_cells(cells);
+}
+
+/**
+ * Outline of all of parent's children at target_res. Traced from the
+ * boundary children's exterior edges in O(n); pentagon parents, whose
+ * missing sector the face tables do not describe edge by edge, and any walk
+ * whose edges fail to chain take the outer rings of the h3lib outline (or
+ * of the Boost union if h3lib fails), one part each.
+ */
+multi_polygon_type children_outline(H3Index parent, int target_res) {
+    PerimeterChildren walk = children_on_boundary_faces_perimeter(parent, target_res, FaceMask::All);
+    multi_polygon_type outline;
+    outline.resize(1);
+    if (!isPentagon(parent) && trace_outline(walk, target_res, outline[0])) {
+        return outline;
+    }
+    outline = cells_to_multi_polygon(walk.cells, OutlineBackend::H3);
+    for (polygon_type& part : outline) {
+        part.inners().clear();
+    }
+    return outline;
+}
+
+/**
+ * Whether a -> b -> c turns left (counter-clockwise). Turns with a sine
+ * below 1e-9 count as straight, so vertices that are collinear up to
+ * rounding are dropped from hulls, as bg::convex_hull does.
+ */
+bool left_turn(const point_type& a, const point_type& b, const point_type& c) {
+    double abx = b.x() - a.x(), aby = b.y() - a.y();
+    double acx = c.x() - a.x(), acy = c.y() - a.y();
+    double cross = abx * acy - aby * acx;
+    return cross > 0 && cross * cross > 1e-18 * (abx * abx + aby * aby) * (acx * acx + acy * acy);
+}
+
+/**
+ * Convex hull of a simple closed ring with Melkman's algorithm: one pass
+ * over the vertices in ring order, keeping the hull in a deque whose both
+ * ends sit on the last vertex added. Linear, where a general hull sorts.
+ * The hull comes out clockwise and closed, like bg::convex_hull.
+ * Returns false if the ring's first three vertices are collinear.
+ */
+bool melkman_hull(const polygon_type::ring_type& ring, polygon_type& hull) {
+    if (ring.size() < 4) {
+        return false;
+    }
+    size_t n = ring.size() - 1;  // without the closing point
+    std::deque<point_type> d;
+    if (left_turn(ring[0], ring[1], ring[2])) {
+        d = {ring[2], ring[0], ring[1], ring[2]};
+    } else if (left_turn(ring[1], ring[0], ring[2])) {
+        d = {ring[2], ring[1], ring[0], ring[2]};
+    } else {
+        return false;
+    }
+    // d is counter-clockwise from here on
+    for (size_t i = 3; i < n; ++i) {
+        const point_type& p = ring[i];
+        if (left_turn(d[d.size() - 2], d.back(), p) && left_turn(d[0], d[1], p)) {
+            continue;  // inside the current hull
+        }
+        while (d.size() > 2 && !left_turn(d[d.size() - 2], d.back(), p)) {
+            d.pop_back();
+        }
+        d.push_back(p);
+        while (d.size() > 2 && !left_turn(p, d[0], d[1])) {
+            d.pop_front();
+        }
+        d.push_front(p);
+    }
+    auto& out = hull.outer();
+    out.assign(d.rbegin(), d.rend());
+    return true;
+}
+
+/**
+ * Returns the cached polygon for key, or computes, caches and returns it.
+ * Bypasses the cache entirely while it is disabled.
+ */
+template <typename Compute>
+PolygonResult cached(const detail::PolygonCacheKey& key, Compute&& compute) {
+    detail::PolygonCache& cache = detail::PolygonCache::instance();
+    if (!cache.enabled()) {
+        return compute();
+    }
+    PolygonResult result;
+    if (cache.lookup(key, result)) {
+        return result;
+    }
+    result = compute();
+    cache.insert(key, result);
     return result;
 }
 
-std::vector<std::pair<double, double>> cell_boundary_from_children(H3Index parent, int target_res) {
-    typedef bg::model::d2::point_xy<double> point_type;
-    typedef bg::model::polygon<point_type> polygon_type;
-    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
-    
-    std::set<int> all_faces = {1, 2, 3, 4, 5, 6};
-    auto boundary_children = children_on_boundary_faces(parent, target_res, all_faces);
-    
-    if (boundary_children.empty()) {
-        return cell_boundary(parent);
+} // namespace
+
+PolygonResult cell_boundary_from_children(H3Index parent, int target_res) {
+    return cached({detail::CachedFunction::BoundaryFromChildren, parent, target_res, 0.0, false,
+                   BufferProjection::Degrees},
+                  [&] { return to_result(children_outline(parent, target_res)); });
+}
+
+PolygonResult cell_polygons_from_children(H3Index parent, int target_res, OutlineBackend backend) {
+    return to_result(cells_to_multi_polygon(
+        children_on_boundary_faces_perimeter(parent, target_res, FaceMask::All).cells, backend));
+}
+
+namespace {
+
+constexpr double kEarthRadiusM = 6371007.180918475;  // h3lib's EARTH_RADIUS_KM
+
+/**
+ * Azimuthal equidistant projection about a point, in meters on H3's
+ * spherical Earth: distances and azimuths from the center are exact, and
+ * across a cell the scale error stays far below the buffer tolerances.
+ */
+class LocalProjection {
+public:
+    LocalProjection(double center_lon, double center_lat)
+        : lon0_(degsToRads(center_lon)), sin_lat0_(std::sin(degsToRads(center_lat))),
+          cos_lat0_(std::cos(degsToRads(center_lat))) {}
+
+    point_type forward(const point_type& lonlat) const {
+        double lat = degsToRads(lonlat.y());
+        double dlon = degsToRads(lonlat.x()) - lon0_;
+        double sin_lat = std::sin(lat), cos_lat = std::cos(lat);
+        double cos_c = sin_lat0_ * sin_lat + cos_lat0_ * cos_lat * std::cos(dlon);
+        double c = std::acos(std::max(-1.0, std::min(1.0, cos_c)));
+        double k = c < 1e-12 ? kEarthRadiusM : kEarthRadiusM * c / std::sin(c);
+        return point_type(k * cos_lat * std::sin(dlon),
+                          k * (cos_lat0_ * sin_lat - sin_lat0_ * cos_lat * std::cos(dlon)));
     }
-    
-    // Union all child cell polygons
-    multi_polygon_type merged;
-    
-    for (H3Index child : boundary_children) {
-        CellBoundary cb;
-        cellToBoundary(child, &cb);
-        
-        polygon_type cell_poly;
-        for (int i = 0; i < cb.numVerts; ++i) {
-            double lon = radsToDegs(cb.verts[i].lng);
-            double lat = radsToDegs(cb.verts[i].lat);
-            bg::append(cell_poly.outer(), point_type(lon, lat));
+
+    point_type inverse(const point_type& xy) const {
+        double rho = std::hypot(xy.x(), xy.y());
+        if (rho < 1e-9) {
+            return point_type(radsToDegs(lon0_), radsToDegs(std::asin(sin_lat0_)));
         }
-        // Close the ring
-        if (cb.numVerts > 0) {
-            bg::append(cell_poly.outer(), point_type(
-                radsToDegs(cb.verts[0].lng),
-                radsToDegs(cb.verts[0].lat)
-            ));
+        double c = rho / kEarthRadiusM;
+        double sin_c = std::sin(c), cos_c = std::cos(c);
+        double lat = std::asin(cos_c * sin_lat0_ + xy.y() * sin_c * cos_lat0_ / rho);
+        double lon = lon0_ + std::atan2(xy.x() * sin_c, rho * cos_lat0_ * cos_c - xy.y() * sin_lat0_ * sin_c);
+        return point_type(radsToDegs(lon), radsToDegs(lat));
+    }
+
+private:
+    double lon0_;
+    double sin_lat0_;
+    double cos_lat0_;
+};
+
+/**
+ * Buffering state kept per thread, so that repeated calls (batches above
+ * all) reuse the strategies and the buffers' capacity.
+ */
+struct BufferScratch {
+    bg::strategy::buffer::join_round join_strategy{32};
+    bg::strategy::buffer::end_round end_strategy{32};
+    bg::strategy::buffer::point_circle point_strategy{32};
+    bg::strategy::buffer::side_straight side_strategy;
+    multi_polygon_type projected;
+    multi_polygon_type buffered;
+};
+
+BufferScratch& buffer_scratch() {
+    thread_local BufferScratch scratch;
+    return scratch;
+}
+
+/**
+ * 'base' buffered by 'distance' with 32-point round joins: convex_offset
+ * when it is a single convex ring, bg::buffer otherwise. The result lives
+ * in 'scratch' until the next call.
+ */
+const multi_polygon_type& buffer_parts(const multi_polygon_type& base, double distance, BufferScratch& scratch) {
+    scratch.buffered.resize(1);
+    scratch.buffered[0].inners().clear();
+    if (base.size() == 1 && base[0].inners().empty() &&
+        detail::convex_offset(base[0].outer(), distance, 32, scratch.buffered[0].outer())) {
+        return scratch.buffered;
+    }
+    bg::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
+    scratch.buffered.clear();
+    bg::buffer(base, scratch.buffered, distance_strategy, scratch.side_strategy, scratch.join_strategy,
+               scratch.end_strategy, scratch.point_strategy);
+    return scratch.buffered;
+}
+
+/**
+ * Buffers lon/lat polygons by buffer_meters, keeping every part and hole of
+ * the result.
+ *
+ * BufferProjection::Degrees converts the distance to degrees with the
+ * average of the latitude and longitude scales at avg_lat and buffers in
+ * lon/lat. With 'reach_everywhere' (the auto buffers) it uses the longitude
+ * scale at the furthest latitude from the equator the buffer can reach
+ * instead, the smallest scale there is, so the buffer reaches buffer_meters
+ * or more in every direction. LocalAzimuthalEquidistant buffers in meters
+ * about 'center' (lon, lat) and projects the result back.
+ */
+PolygonResult buffer_polygon(const multi_polygon_type& base, double buffer_meters, double avg_lat,
+                             const point_type& center, BufferProjection projection, bool reach_everywhere) {
+    BufferScratch& scratch = buffer_scratch();
+    PolygonResult result;
+
+    if (projection == BufferProjection::LocalAzimuthalEquidistant) {
+        LocalProjection local(center.x(), center.y());
+        multi_polygon_type& projected = scratch.projected;
+        projected.resize(base.size());
+        for (size_t k = 0; k < base.size(); ++k) {
+            projected[k].outer().clear();
+            projected[k].inners().resize(base[k].inners().size());
+            for (const auto& pt : base[k].outer()) {
+                projected[k].outer().push_back(local.forward(pt));
+            }
+            for (size_t h = 0; h < base[k].inners().size(); ++h) {
+                projected[k].inners()[h].clear();
+                for (const auto& pt : base[k].inners()[h]) {
+                    projected[k].inners()[h].push_back(local.forward(pt));
+                }
+            }
         }
-        bg::correct(cell_poly);
-        
-        multi_polygon_type union_result;
-        bg::union_(merged, cell_poly, union_result);
-        merged = union_result;
+        bg::correct(projected);
+        append_parts(buffer_parts(projected, buffer_meters, scratch), result,
+                     [&](const point_type& pt) { return local.inverse(pt); });
+        return result;
     }
-    
-    // Extract exterior ring
-    std::vector<std::pair<double, double>> result;
-    if (!merged.empty()) {
-        for (const auto& pt : merged[0].outer()) {
-            result.emplace_back(pt.x(), pt.y());
+
+    // Convert buffer from meters to degrees
+    double buffer_degrees;
+    if (reach_everywhere) {
+        const double meters_per_degree = kEarthRadiusM * M_PI / 180.0;
+        double max_lat = 0.0;
+        for (const polygon_type& part : base) {
+            for (const auto& pt : part.outer()) {
+                max_lat = std::max(max_lat, std::abs(pt.y()));
+            }
         }
+        double lat_scale = std::min(max_lat + buffer_meters / meters_per_degree, 89.0);
+        buffer_degrees = buffer_meters / (meters_per_degree * std::cos(degsToRads(lat_scale)));
+    } else {
+        const double meters_per_degree_lat = 111320.0;
+        const double meters_per_degree_lon = 111320.0 * std::abs(std::cos(avg_lat * M_PI / 180.0));
+        double avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2.0;
+        buffer_degrees = buffer_meters / avg_meters_per_degree;
     }
+
+    append_parts(buffer_parts(base, buffer_degrees, scratch), result, [](const point_type& pt) { return pt; });
     return result;
 }
 
-std::vector<std::pair<double, double>> get_buffered_h3_polygon(H3Index cell, double buffer_meters) {
-    typedef bg::model::d2::point_xy<double> point_type;
-    typedef bg::model::polygon<point_type> polygon_type;
-    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
-    
+/** The cell's center as a (lon, lat) point. */
+point_type cell_center(H3Index cell) {
+    LatLng center;
+    cellToLatLng(cell, &center);
+    return point_type(radsToDegs(center.lng), radsToDegs(center.lat));
+}
+
+PolygonResult compute_buffered_h3_polygon(H3Index cell, double buffer_meters, BufferProjection projection) {
     // Get cell boundary
     CellBoundary cb;
     cellToBoundary(cell, &cb);
     
-    polygon_type poly;
+    multi_polygon_type base;
+    base.resize(1);
+    polygon_type& poly = base[0];
     double lat_sum = 0.0;
     for (int i = 0; i < cb.numVerts; ++i) {
         double lon = radsToDegs(cb.verts[i].lng);
@@ -373,47 +607,24 @@ std::vector<std::pair<double, double>> get_buffered_h3_polygon(H3Index cell, dou
     }
     bg::correct(poly);
     
-    // Auto-calculate buffer if not specified
-    if (buffer_meters < 0) {
-        int res = getResolution(cell);
-        int intermediate_res = std::min(res + 4, 15);
-        double edge_km;
-        getHexagonEdgeLengthAvgKm(intermediate_res, &edge_km);
-        buffer_meters = edge_km * 1000.0;
+    // Auto: just enough to cover the res 15 descendants
+    bool automatic = buffer_meters < 0;
+    if (automatic) {
+        buffer_meters = max_descendant_overhang(getResolution(cell), 15, isPentagon(cell));
     }
-    
-    // Convert buffer from meters to degrees
-    double avg_lat = lat_sum / cb.numVerts;
-    const double meters_per_degree_lat = 111320.0;
-    const double meters_per_degree_lon = 111320.0 * std::abs(std::cos(avg_lat * M_PI / 180.0));
-    double avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2.0;
-    double buffer_degrees = buffer_meters / avg_meters_per_degree;
-    
-    // Apply buffer
-    multi_polygon_type buffered;
-    bg::strategy::buffer::distance_symmetric<double> distance_strategy(buffer_degrees);
-    bg::strategy::buffer::join_round join_strategy(32);
-    bg::strategy::buffer::end_round end_strategy(32);
-    bg::strategy::buffer::point_circle point_strategy(32);
-    bg::strategy::buffer::side_straight side_strategy;
-    
-    bg::buffer(poly, buffered, distance_strategy, side_strategy, join_strategy, end_strategy, point_strategy);
-    
-    // Extract result
-    std::vector<std::pair<double, double>> result;
-    if (!buffered.empty()) {
-        for (const auto& pt : buffered[0].outer()) {
-            result.emplace_back(pt.x(), pt.y());
-        }
+    if (buffer_meters == 0) {
+        return to_result(base);
     }
-    return result;
+    
+    return buffer_polygon(base, buffer_meters, lat_sum / cb.numVerts, cell_center(cell), projection, automatic);
 }
 
-std::vector<std::pair<double, double>> get_buffered_boundary_polygon(
+PolygonResult compute_buffered_boundary_polygon(
     H3Index cell,
     int intermediate_res,
     double buffer_meters,
-    bool use_convex_hull
+    bool use_convex_hull,
+    BufferProjection projection
 ) {
     int cell_res = getResolution(cell);
     
@@ -425,127 +636,368 @@ std::vector<std::pair<double, double>> get_buffered_boundary_polygon(
         intermediate_res = 15;
     }
     
-    // Get boundary children at intermediate resolution
-    std::set<int> all_faces = {1, 2, 3, 4, 5, 6};
-    auto boundary_children = children_on_boundary_faces(cell, intermediate_res, all_faces);
-    
-    if (boundary_children.empty()) {
-        // Fallback: return cell boundary directly
-        CellBoundary cb;
-        cellToBoundary(cell, &cb);
-        std::vector<std::pair<double, double>> result;
-        for (int i = 0; i < cb.numVerts; ++i) {
-            result.emplace_back(radsToDegs(cb.verts[i].lng), radsToDegs(cb.verts[i].lat));
-        }
-        return result;
-    }
-    
-    typedef bg::model::d2::point_xy<double> point_type;
-    typedef bg::model::polygon<point_type> polygon_type;
-    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
-    
     double lat_sum = 0.0;
     int point_count = 0;
-    polygon_type base_polygon;
+    multi_polygon_type base;
+    base.resize(1);
+    polygon_type& base_polygon = base[0];
     
     if (use_convex_hull) {
-        // Fast mode: compute convex hull of all boundary vertices
-        typedef bg::model::multi_point<point_type> multi_point_type;
-        multi_point_type all_points;
-        
-        for (H3Index child : boundary_children) {
-            CellBoundary cb;
-            cellToBoundary(child, &cb);
-            for (int i = 0; i < cb.numVerts; ++i) {
-                double lon = radsToDegs(cb.verts[i].lng);
-                double lat = radsToDegs(cb.verts[i].lat);
-                bg::append(all_points, point_type(lon, lat));
-                lat_sum += lat;
+        // Fast mode: convex hull of the exterior vertices only. The traced
+        // outline is a simple ring in perimeter order, so Melkman's algorithm
+        // hulls it in linear time; pentagons hull every child vertex instead.
+        PerimeterChildren walk = children_on_boundary_faces_perimeter(cell, intermediate_res, FaceMask::All);
+        polygon_type outline;
+        if (!isPentagon(cell) && trace_outline(walk, intermediate_res, outline) &&
+            melkman_hull(outline.outer(), base_polygon)) {
+            for (const auto& pt : outline.outer()) {
+                lat_sum += pt.y();
                 ++point_count;
             }
+        } else {
+            typedef bg::model::multi_point<point_type> multi_point_type;
+            multi_point_type all_points;
+
+            for (H3Index child : walk.cells) {
+                CellBoundary cb;
+                cellToBoundary(child, &cb);
+                for (int i = 0; i < cb.numVerts; ++i) {
+                    double lon = radsToDegs(cb.verts[i].lng);
+                    double lat = radsToDegs(cb.verts[i].lat);
+                    bg::append(all_points, point_type(lon, lat));
+                    lat_sum += lat;
+                    ++point_count;
+                }
+            }
+
+            bg::convex_hull(all_points, base_polygon);
         }
-        
-        bg::convex_hull(all_points, base_polygon);
     } else {
-        // Accurate mode: union all cell polygons
-        multi_polygon_type merged;
-        
-        for (H3Index child : boundary_children) {
-            CellBoundary cb;
-            cellToBoundary(child, &cb);
-            
-            // Create polygon for this cell
-            polygon_type cell_poly;
-            for (int i = 0; i < cb.numVerts; ++i) {
-                double lon = radsToDegs(cb.verts[i].lng);
-                double lat = radsToDegs(cb.verts[i].lat);
-                bg::append(cell_poly.outer(), point_type(lon, lat));
-                lat_sum += lat;
+        // Accurate mode: exact outline of the boundary children
+        base = children_outline(cell, intermediate_res);
+        for (const polygon_type& part : base) {
+            for (const auto& pt : part.outer()) {
+                lat_sum += pt.y();
                 ++point_count;
             }
-            // Close the ring
-            if (cb.numVerts > 0) {
-                bg::append(cell_poly.outer(), point_type(
-                    radsToDegs(cb.verts[0].lng), 
-                    radsToDegs(cb.verts[0].lat)
-                ));
-            }
-            bg::correct(cell_poly);
-            
-            // Union with merged result
-            multi_polygon_type union_result;
-            bg::union_(merged, cell_poly, union_result);
-            merged = union_result;
-        }
-        
-        // Take the first polygon from the multi_polygon
-        if (!merged.empty()) {
-            base_polygon = merged[0];
         }
     }
     
-    // Auto-calculate buffer if not specified
-    if (buffer_meters < 0) {
-        double edge_km;
-        getHexagonEdgeLengthAvgKm(intermediate_res, &edge_km);
-        buffer_meters = edge_km * 1000.0;
+    // Auto: the overhang of the intermediate children's res 15 descendants.
+    // Pentagon children are never on the outline, and overhang less anyway.
+    bool automatic = buffer_meters < 0;
+    if (automatic) {
+        buffer_meters = max_descendant_overhang(intermediate_res, 15);
     }
     
     // If no buffer needed, return base polygon directly
     if (buffer_meters == 0 || intermediate_res >= 15) {
-        std::vector<std::pair<double, double>> result;
-        for (const auto& pt : base_polygon.outer()) {
-            result.emplace_back(pt.x(), pt.y());
-        }
-        return result;
+        return to_result(base);
     }
     
-    // Convert buffer from meters to degrees
-    double avg_lat = lat_sum / point_count;
-    const double meters_per_degree_lat = 111320.0;
-    const double meters_per_degree_lon = 111320.0 * std::abs(std::cos(avg_lat * M_PI / 180.0));
-    double avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2.0;
-    double buffer_degrees = buffer_meters / avg_meters_per_degree;
-    
-    // Apply buffer
-    multi_polygon_type buffered;
-    bg::strategy::buffer::distance_symmetric<double> distance_strategy(buffer_degrees);
-    bg::strategy::buffer::join_round join_strategy(32);
-    bg::strategy::buffer::end_round end_strategy(32);
-    bg::strategy::buffer::point_circle point_strategy(32);
-    bg::strategy::buffer::side_straight side_strategy;
-    
-    bg::buffer(base_polygon, buffered, distance_strategy, side_strategy, join_strategy, end_strategy, point_strategy);
-    
-    // Extract result
-    std::vector<std::pair<double, double>> result;
-    if (!buffered.empty()) {
-        for (const auto& pt : buffered[0].outer()) {
-            result.emplace_back(pt.x(), pt.y());
+    return buffer_polygon(base, buffer_meters, lat_sum / point_count, cell_center(cell), projection, automatic);
+}
+
+/**
+ * Equirectangular plane about (lon0, lat0), in meters. It is affine in
+ * lon/lat, so straight lon/lat edges stay straight both ways. East-west
+ * distances use the scale at lat_scale: taken at the latitude farthest from
+ * the equator, plane distances never exceed true ones, so a buffer of d in
+ * the plane reaches at least d on the ground.
+ */
+class LocalPlane {
+public:
+    LocalPlane(const point_type& origin, double lat_scale)
+        : lon0_(origin.x()), lat0_(origin.y()),
+          kx_(kEarthRadiusM * std::cos(degsToRads(lat_scale)) * M_PI / 180.0),
+          ky_(kEarthRadiusM * M_PI / 180.0) {}
+
+    point_type forward(const point_type& lonlat) const {
+        return point_type((lonlat.x() - lon0_) * kx_, (lonlat.y() - lat0_) * ky_);
+    }
+    point_type inverse(const point_type& xy) const {
+        return point_type(lon0_ + xy.x() / kx_, lat0_ + xy.y() / ky_);
+    }
+
+private:
+    double lon0_;
+    double lat0_;
+    double kx_;
+    double ky_;
+};
+
+/**
+ * Shrinks a convex ring (closed) to at most max_vertices vertices, only
+ * ever growing the area it covers: each step drops the edge whose two
+ * neighbours, extended until they meet, add the least area. Stops early at
+ * three vertices or when every remaining edge has diverging neighbours.
+ */
+void simplify_outward(polygon_type::ring_type& ring, size_t max_vertices) {
+    size_t n = ring.size() - 1;
+    if (n <= max_vertices) {
+        return;
+    }
+    std::vector<point_type> v(ring.begin(), ring.end() - 1);
+    std::vector<size_t> next(n), prev(n);
+    std::vector<uint32_t> version(n, 0);
+    std::vector<char> alive(n, 1);
+    for (size_t i = 0; i < n; ++i) {
+        next[i] = (i + 1) % n;
+        prev[i] = (i + n - 1) % n;
+    }
+
+    // Where the edges before and after edge (a, next(a)) meet, if beyond both ends
+    auto corner = [&](size_t a, point_type& p, double& cost) {
+        size_t b = next[a];
+        double dx1 = v[a].x() - v[prev[a]].x(), dy1 = v[a].y() - v[prev[a]].y();
+        double dx2 = v[b].x() - v[next[b]].x(), dy2 = v[b].y() - v[next[b]].y();
+        double ex = v[b].x() - v[a].x(), ey = v[b].y() - v[a].y();
+        double denom = dx1 * dy2 - dy1 * dx2;
+        if (denom == 0) {
+            return false;
+        }
+        double t = (ex * dy2 - ey * dx2) / denom;
+        double u = (ex * dy1 - ey * dx1) / denom;
+        if (t <= 0 || u <= 0) {
+            return false;
         }
+        p = point_type(v[a].x() + t * dx1, v[a].y() + t * dy1);
+        cost = std::abs(ex * (p.y() - v[a].y()) - ey * (p.x() - v[a].x())) / 2;
+        return true;
+    };
+
+    typedef std::tuple<double, size_t, uint32_t> Candidate;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+    auto push = [&](size_t a) {
+        point_type p;
+        double cost;
+        if (corner(a, p, cost)) {
+            queue.emplace(cost, a, version[a]);
+        }
+    };
+    for (size_t i = 0; i < n; ++i) {
+        push(i);
     }
-    
-    return result;
+
+    size_t count = n;
+    while (count > max_vertices && count > 3 && !queue.empty()) {
+        auto [cost, a, stamp] = queue.top();
+        queue.pop();
+        point_type p;
+        if (!alive[a] || stamp != version[a] || !corner(a, p, cost)) {
+            continue;
+        }
+        // Edge (a, b) collapses onto p, the meeting point of its neighbours
+        size_t b = next[a];
+        v[a] = p;
+        alive[b] = 0;
+        next[a] = next[b];
+        prev[next[b]] = a;
+        --count;
+        for (size_t k : {prev[prev[a]], prev[a], a, next[a]}) {
+            ++version[k];
+            push(k);
+        }
+    }
+
+    size_t start = 0;
+    while (!alive[start]) {
+        ++start;
+    }
+    ring.clear();
+    size_t i = start;
+    do {
+        ring.push_back(v[i]);
+        i = next[i];
+    } while (i != start);
+    ring.push_back(v[start]);
+}
+
+/** Points per full circle tried for the round joins of a containment polygon. */
+constexpr int kArcSegments[] = {8, 12, 16, 24, 32};
+
+/**
+ * The best containment polygon for one intermediate resolution: the convex
+ * hull of the boundary children's exterior vertices, buffered in a
+ * LocalPlane with arcs pushed out to stay outside the true circle, then
+ * simplified outward. Tries every arc segmentation and keeps the least
+ * inflated result.
+ */
+ContainmentPolygon containment_at(H3Index cell, int res, double buffer_meters, size_t max_vertices) {
+    std::vector<point_type> points;
+    PerimeterChildren walk = children_on_boundary_faces_perimeter(cell, res, FaceMask::All);
+    polygon_type outline;
+    bool traced = !isPentagon(cell) && trace_outline(walk, res, outline);
+    if (traced) {
+        points.assign(outline.outer().begin(), outline.outer().end());
+    } else {
+        for (H3Index child : walk.cells) {
+            CellBoundary cb;
+            cellToBoundary(child, &cb);
+            for (int i = 0; i < cb.numVerts; ++i) {
+                points.emplace_back(radsToDegs(cb.verts[i].lng), radsToDegs(cb.verts[i].lat));
+            }
+        }
+    }
+    PolygonResult boundary = cell_boundary(cell);
+    polygon_type cell_ring;
+    for (size_t i = 0; i < boundary.num_points(); ++i) {
+        cell_ring.outer().push_back(point_type(boundary.coords[2 * i], boundary.coords[2 * i + 1]));
+    }
+    bg::correct(cell_ring);
+
+    double max_abs_lat = 0;
+    for (const auto& pt : points) {
+        max_abs_lat = std::max(max_abs_lat, std::abs(pt.y()));
+    }
+    // The plane's scale must hold out to the result's extreme latitude, which
+    // only the result tells; start a buffer's width out and widen if needed.
+    double lat_scale = max_abs_lat + radsToDegs(2 * buffer_meters / kEarthRadiusM);
+
+    ContainmentPolygon best;
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        LocalPlane plane(cell_center(cell), std::min(lat_scale, 89.9));
+        polygon_type hull;
+        polygon_type projected;
+        for (const auto& pt : points) {
+            projected.outer().push_back(plane.forward(pt));
+        }
+        if (!traced || !melkman_hull(projected.outer(), hull)) {
+            bg::model::multi_point<point_type> cloud(projected.outer().begin(), projected.outer().end());
+            bg::convex_hull(cloud, hull);
+        }
+        polygon_type cell_projected;
+        for (const auto& pt : cell_ring.outer()) {
+            cell_projected.outer().push_back(plane.forward(pt));
+        }
+        double cell_area = std::abs(bg::area(cell_projected));
+
+        polygon_type::ring_type best_ring;
+        best.inflation = std::numeric_limits<double>::infinity();
+        for (int segments : kArcSegments) {
+            polygon_type::ring_type ring;
+            if (buffer_meters > 0) {
+                // Round joins put their vertices on the circle, so chords cut
+                // inside it by up to 1 - cos(pi / segments); scale the radius
+                // so the chords stay at least buffer_meters out.
+                double radius = buffer_meters / std::cos(M_PI / segments);
+                if (!detail::convex_offset(hull.outer(), radius, segments, ring)) {
+                    multi_polygon_type buffered;
+                    bg::buffer(hull, buffered, bg::strategy::buffer::distance_symmetric<double>(radius),
+                               bg::strategy::buffer::side_straight(), bg::strategy::buffer::join_round(segments),
+                               bg::strategy::buffer::end_round(segments), bg::strategy::buffer::point_circle(segments));
+                    if (buffered.empty()) {
+                        continue;
+                    }
+                    ring = buffered[0].outer();
+                }
+            } else {
+                ring = hull.outer();
+            }
+            simplify_outward(ring, max_vertices);
+            double inflation = std::abs(bg::area(ring)) / cell_area;
+            if (inflation < best.inflation) {
+                best.inflation = inflation;
+                best.arc_segments = buffer_meters > 0 ? segments : 0;
+                best_ring = std::move(ring);
+            }
+            if (buffer_meters <= 0) {
+                break;
+            }
+        }
+
+        best.polygon = PolygonResult();
+        double result_lat = 0;
+        for (const auto& pt : best_ring) {
+            point_type lonlat = plane.inverse(pt);
+            best.polygon.add_point(lonlat.x(), lonlat.y());
+            result_lat = std::max(result_lat, std::abs(lonlat.y()));
+        }
+        if (!best_ring.empty()) {
+            best.polygon.end_ring();
+            best.polygon.end_part();
+        }
+        if (result_lat <= lat_scale) {
+            break;
+        }
+        lat_scale = result_lat;
+    }
+    best.vertex_count = best.polygon.empty() ? 0 : best.polygon.num_points() - 1;
+    best.intermediate_res = res;
+    best.buffer_meters = buffer_meters;
+    return best;
+}
+
+/**
+ * The cache key for a buffer argument. Every negative buffer means "auto", so
+ * they share one entry, and -0.0 becomes 0.0 so that equal keys hash alike.
+ * NaN would never equal its own key, so non-finite buffers are rejected.
+ */
+double key_buffer(double buffer_meters) {
+    if (!std::isfinite(buffer_meters)) {
+        throw std::invalid_argument("buffer_meters must be finite");
+    }
+    return buffer_meters < 0 ? -1.0 : (buffer_meters == 0 ? 0.0 : buffer_meters);
+}
+
+} // namespace
+
+double max_descendant_overhang(int res, int descendant_res, bool pentagon) {
+    if (res < 0 || descendant_res < res || descendant_res > 15) {
+        throw std::invalid_argument("need 0 <= res <= descendant_res <= 15");
+    }
+    return detail::kDescendantOverhangM[pentagon ? 1 : 0][res][descendant_res];
+}
+
+PolygonResult get_buffered_h3_polygon(H3Index cell, double buffer_meters, BufferProjection projection) {
+    return cached({detail::CachedFunction::BufferedCell, cell, 0, key_buffer(buffer_meters), false, projection},
+                  [&] { return compute_buffered_h3_polygon(cell, buffer_meters, projection); });
+}
+
+PolygonResult get_buffered_boundary_polygon(
+    H3Index cell,
+    int intermediate_res,
+    double buffer_meters,
+    bool use_convex_hull,
+    BufferProjection projection
+) {
+    return cached({detail::CachedFunction::BufferedBoundary, cell, intermediate_res, key_buffer(buffer_meters),
+                   use_convex_hull, projection},
+                  [&] {
+                      return compute_buffered_boundary_polygon(cell, intermediate_res, buffer_meters, use_convex_hull,
+                                                               projection);
+                  });
+}
+
+ContainmentPolygon get_containment_polygon(H3Index cell, const ContainmentBudget& budget) {
+    int cell_res = getResolution(cell);
+    if (cell_res >= 15) {
+        throw std::invalid_argument("cell resolution must be below 15");
+    }
+    if (budget.max_vertices < 3) {
+        throw std::invalid_argument("max_vertices must be at least 3");
+    }
+    int lo = budget.min_intermediate_res > 0 ? budget.min_intermediate_res : cell_res + 1;
+    int hi = budget.max_intermediate_res > 0 ? budget.max_intermediate_res : cell_res + 4;
+    lo = std::max(lo, cell_res + 1);
+    hi = std::min(std::max(hi, lo), 15);
+
+    ContainmentPolygon best;
+    for (int res = lo; res <= hi; ++res) {
+        double buffer_meters = budget.buffer_meters < 0 ? max_descendant_overhang(res, 15) : budget.buffer_meters;
+        ContainmentPolygon candidate = containment_at(cell, res, buffer_meters, budget.max_vertices);
+        bool improved = best.polygon.empty() || candidate.inflation < best.inflation;
+        // Finer resolutions cost ~7x more each; stop once they stop paying off
+        bool worth_going_on = best.polygon.empty() || candidate.inflation < best.inflation * 0.995;
+        if (improved) {
+            best = std::move(candidate);
+        }
+        if (!worth_going_on) {
+            break;
+        }
+    }
+    best.within_budget = best.vertex_count <= budget.max_vertices && best.inflation <= budget.max_inflation;
+    return best;
 }
 
 } // namespace h3_toolkit
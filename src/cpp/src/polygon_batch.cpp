@@ -0,0 +1,174 @@
+/**
+ * @file polygon_batch.cpp
+ * @brief Batch forms of the geometry functions, with CSR output.
+ *
+ * Cells are cut into fixed-size blocks that the shared pool computes into
+ * block-local buffers; a second pass copies the blocks into the flat output
+ * once their sizes, and so their offsets, are known.
+ */
+
+#include "h3_toolkit.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace h3_toolkit {
+
+namespace {
+
+/** Cells per task: enough to amortize a block's buffers, few enough to balance. */
+constexpr size_t kCellsPerBlock = 64;
+
+/** A block's polygons, with sizes in place of offsets. */
+struct Block {
+    std::vector<double> coords;
+    std::vector<uint64_t> ring_points;
+    std::vector<uint64_t> part_rings;
+    std::vector<uint32_t> polygon_parts;
+
+    /** Appends a polygon's parts and rings. */
+    void append(const PolygonResult& polygon) {
+        coords.insert(coords.end(), polygon.coords.begin(), polygon.coords.end());
+        for (size_t j = 0; j < polygon.num_rings(); ++j) {
+            ring_points.push_back(polygon.ring_offsets[j + 1] - polygon.ring_offsets[j]);
+        }
+        for (size_t k = 0; k < polygon.num_parts(); ++k) {
+            part_rings.push_back(polygon.part_offsets[k + 1] - polygon.part_offsets[k]);
+        }
+    }
+};
+
+/**
+ * Runs compute(cell, block) for every cell: it appends the cell's parts to
+ * the block (see Block::append).
+ */
+template <typename Compute>
+PolygonBatch run_batch(const H3Index* cells, size_t count, int num_threads, const Compute& compute) {
+    PolygonBatch batch;
+    batch.status.assign(count, E_SUCCESS);
+    size_t num_blocks = (count + kCellsPerBlock - 1) / kCellsPerBlock;
+    std::vector<Block> blocks(num_blocks);
+
+    detail::ThreadPool::shared().parallel_for(num_blocks, [&](size_t b) {
+        Block& block = blocks[b];
+        size_t begin = b * kCellsPerBlock;
+        size_t end = std::min(count, begin + kCellsPerBlock);
+        block.polygon_parts.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            size_t parts_before = block.part_rings.size();
+            if (!isValidCell(cells[i])) {
+                batch.status[i] = E_CELL_INVALID;
+            } else {
+                // The shared arguments are checked before the batch runs, so
+                // what throws here is a resolution this cell cannot take
+                try {
+                    compute(cells[i], block);
+                } catch (const std::invalid_argument&) {
+                    batch.status[i] = E_RES_DOMAIN;
+                }
+            }
+            block.polygon_parts.push_back(static_cast<uint32_t>(block.part_rings.size() - parts_before));
+            // Cells of a batch mostly give polygons of one size; size the block on the first
+            if (i == begin && !block.coords.empty()) {
+                block.coords.reserve(block.coords.size() * (end - begin));
+                block.ring_points.reserve(block.ring_points.size() * (end - begin));
+                block.part_rings.reserve(block.part_rings.size() * (end - begin));
+            }
+        }
+    }, num_threads);
+
+    std::vector<uint64_t> point_base(num_blocks + 1, 0);
+    std::vector<uint64_t> ring_base(num_blocks + 1, 0);
+    std::vector<uint64_t> part_base(num_blocks + 1, 0);
+    for (size_t b = 0; b < num_blocks; ++b) {
+        point_base[b + 1] = point_base[b] + blocks[b].coords.size() / 2;
+        ring_base[b + 1] = ring_base[b] + blocks[b].ring_points.size();
+        part_base[b + 1] = part_base[b] + blocks[b].part_rings.size();
+    }
+    batch.coords.resize(2 * point_base[num_blocks]);
+    batch.ring_offsets.resize(ring_base[num_blocks] + 1);
+    batch.part_offsets.resize(part_base[num_blocks] + 1);
+    batch.polygon_offsets.resize(count + 1);
+    batch.ring_offsets.back() = point_base[num_blocks];
+    batch.part_offsets.back() = ring_base[num_blocks];
+    batch.polygon_offsets.back() = part_base[num_blocks];
+
+    detail::ThreadPool::shared().parallel_for(num_blocks, [&](size_t b) {
+        const Block& block = blocks[b];
+        if (!block.coords.empty()) {
+            std::memcpy(batch.coords.data() + 2 * point_base[b], block.coords.data(),
+                        block.coords.size() * sizeof(double));
+        }
+        uint64_t point = point_base[b];
+        for (size_t j = 0; j < block.ring_points.size(); ++j) {
+            batch.ring_offsets[ring_base[b] + j] = point;
+            point += block.ring_points[j];
+        }
+        uint64_t ring = ring_base[b];
+        for (size_t k = 0; k < block.part_rings.size(); ++k) {
+            batch.part_offsets[part_base[b] + k] = ring;
+            ring += block.part_rings[k];
+        }
+        uint64_t part = part_base[b];
+        for (size_t i = 0; i < block.polygon_parts.size(); ++i) {
+            batch.polygon_offsets[b * kCellsPerBlock + i] = part;
+            part += block.polygon_parts[i];
+        }
+    }, num_threads);
+    return batch;
+}
+
+/** Rejects a shared buffer that every cell would fail on, as the single-cell functions do. */
+void check_buffer(double buffer_meters) {
+    if (!std::isfinite(buffer_meters)) {
+        throw std::invalid_argument("buffer_meters must be finite");
+    }
+}
+
+} // namespace
+
+PolygonBatch cell_boundaries(const H3Index* cells, size_t count, const ParallelOptions& options) {
+    // Straight from h3lib into the block, as cell_boundary builds its ring
+    return run_batch(cells, count, options.num_threads, [](H3Index cell, Block& block) {
+        CellBoundary cb;
+        cellToBoundary(cell, &cb);
+        if (cb.numVerts == 0) {
+            return;
+        }
+        for (int i = 0; i <= cb.numVerts; ++i) {
+            const LatLng& v = cb.verts[i % cb.numVerts];
+            block.coords.push_back(radsToDegs(v.lng));
+            block.coords.push_back(radsToDegs(v.lat));
+        }
+        block.ring_points.push_back(static_cast<uint64_t>(cb.numVerts) + 1);
+        block.part_rings.push_back(1);
+    });
+}
+
+PolygonBatch cell_boundaries_from_children(const H3Index* cells, size_t count, int target_res,
+                                           const ParallelOptions& options) {
+    return run_batch(cells, count, options.num_threads, [&](H3Index cell, Block& block) {
+        block.append(cell_boundary_from_children(cell, target_res));
+    });
+}
+
+PolygonBatch get_buffered_h3_polygons(const H3Index* cells, size_t count, double buffer_meters,
+                                      BufferProjection projection, const ParallelOptions& options) {
+    check_buffer(buffer_meters);
+    return run_batch(cells, count, options.num_threads, [&](H3Index cell, Block& block) {
+        block.append(get_buffered_h3_polygon(cell, buffer_meters, projection));
+    });
+}
+
+PolygonBatch get_buffered_boundary_polygons(const H3Index* cells, size_t count, int intermediate_res,
+                                            double buffer_meters, bool use_convex_hull,
+                                            BufferProjection projection, const ParallelOptions& options) {
+    check_buffer(buffer_meters);
+    return run_batch(cells, count, options.num_threads, [&](H3Index cell, Block& block) {
+        block.append(get_buffered_boundary_polygon(cell, intermediate_res, buffer_meters, use_convex_hull, projection));
+    });
+}
+
+} // namespace h3_toolkit
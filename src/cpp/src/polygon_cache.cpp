@@ -0,0 +1,156 @@
+/**
+ * @file polygon_cache.cpp
+ * @brief Sharded LRU cache for the geometry functions' results.
+ */
+
+#include "polygon_cache.hpp"
+#include <cstring>
+
+namespace h3_toolkit {
+namespace detail {
+
+namespace {
+
+/** Fixed per-entry cost on top of the coordinates: list node, index slot, control block. */
+constexpr size_t kEntryOverhead = 128;
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= UINT64_C(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace
+
+size_t PolygonCache::KeyHash::operator()(const PolygonCacheKey& key) const {
+    // -0.0 == 0.0, so both must hash alike
+    double buffer = key.buffer_meters == 0 ? 0.0 : key.buffer_meters;
+    uint64_t buffer_bits;
+    std::memcpy(&buffer_bits, &buffer, sizeof(buffer_bits));
+    uint64_t h = mix(key.cell);
+    h = mix(h ^ buffer_bits);
+    h = mix(h ^ (static_cast<uint64_t>(key.projection) << 24) ^ (static_cast<uint64_t>(key.res) << 16) ^
+            (static_cast<uint64_t>(key.function) << 8) ^ static_cast<uint64_t>(key.use_convex_hull));
+    return static_cast<size_t>(h);
+}
+
+PolygonCache& PolygonCache::instance() {
+    static PolygonCache cache;
+    return cache;
+}
+
+PolygonCache::Shard& PolygonCache::shard_for(const PolygonCacheKey& key) {
+    // Top bits pick the shard; the shard's hash map uses the low ones
+    return shards_[(KeyHash()(key) >> 60) % kNumShards];
+}
+
+bool PolygonCache::lookup(const PolygonCacheKey& key, Polygon& out) {
+    Shard& shard = shard_for(key);
+    std::shared_ptr<const Polygon> found;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            ++shard.misses;
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        found = it->second->polygon;
+        ++shard.hits;
+    }
+    out = *found;
+    return true;
+}
+
+void PolygonCache::insert(const PolygonCacheKey& key, const Polygon& polygon) {
+    size_t budget = capacity_.load(std::memory_order_relaxed) / kNumShards;
+    size_t bytes = kEntryOverhead + polygon.coords.size() * sizeof(double) +
+                   (polygon.ring_offsets.size() + polygon.part_offsets.size()) * sizeof(uint32_t);
+    if (bytes > budget) {
+        return;
+    }
+    auto shared = std::make_shared<const Polygon>(polygon);
+
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // set_capacity stores the new capacity before it takes each shard lock,
+    // so re-read under ours: a shrink or disable either sees this entry and
+    // evicts it, or is seen here
+    budget = capacity_.load(std::memory_order_relaxed) / kNumShards;
+    if (bytes > budget) {
+        return;
+    }
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        // Another thread computed the same polygon first
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+    evict_to(shard, budget - bytes);
+    shard.lru.push_front({key, std::move(shared), bytes});
+    shard.index.emplace(key, shard.lru.begin());
+    shard.bytes += bytes;
+}
+
+void PolygonCache::evict_to(Shard& shard, size_t budget) {
+    while (shard.bytes > budget && !shard.lru.empty()) {
+        const Entry& victim = shard.lru.back();
+        shard.bytes -= victim.bytes;
+        shard.index.erase(victim.key);
+        shard.lru.pop_back();
+        ++shard.evictions;
+    }
+}
+
+void PolygonCache::set_capacity(size_t bytes) {
+    capacity_.store(bytes, std::memory_order_relaxed);
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        evict_to(shard, bytes / kNumShards);
+    }
+}
+
+void PolygonCache::clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.lru.clear();
+        shard.index.clear();
+        shard.bytes = 0;
+        shard.hits = 0;
+        shard.misses = 0;
+        shard.evictions = 0;
+    }
+}
+
+PolygonCacheStats PolygonCache::stats() {
+    PolygonCacheStats stats;
+    stats.capacity_bytes = capacity_.load(std::memory_order_relaxed);
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.evictions += shard.evictions;
+        stats.entries += shard.index.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+
+} // namespace detail
+
+void set_polygon_cache_capacity(size_t bytes) {
+    detail::PolygonCache::instance().set_capacity(bytes);
+}
+
+void clear_polygon_cache() {
+    detail::PolygonCache::instance().clear();
+}
+
+PolygonCacheStats polygon_cache_stats() {
+    return detail::PolygonCache::instance().stats();
+}
+
+} // namespace h3_toolkit
@@ -0,0 +1,106 @@
+/**
+ * @file polygon_cache.hpp
+ * @brief Sharded LRU cache for the geometry functions' results.
+ *
+ * Internal header; the public knobs are set_polygon_cache_capacity,
+ * clear_polygon_cache and polygon_cache_stats in h3_toolkit.hpp.
+ *
+ * Keys are spread over independent shards, each with its own mutex, LRU list
+ * and slice of the byte budget, so concurrent lookups of different keys
+ * rarely contend and no lookup takes a cache-wide lock. Polygons are shared
+ * between the cache and in-flight readers, so a hit copies its result
+ * after releasing the shard lock and an eviction never invalidates it.
+ */
+
+#pragma once
+
+#include "h3_toolkit.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace h3_toolkit {
+namespace detail {
+
+/** Which geometry function a cached polygon came from. */
+enum class CachedFunction : uint8_t {
+    BoundaryFromChildren,
+    BufferedCell,
+    BufferedBoundary,
+};
+
+/** A cached call: the function and every argument that affects its result. */
+struct PolygonCacheKey {
+    CachedFunction function;
+    H3Index cell;
+    int res;
+    double buffer_meters;
+    bool use_convex_hull;
+    BufferProjection projection;
+
+    bool operator==(const PolygonCacheKey& other) const {
+        return function == other.function && cell == other.cell && res == other.res &&
+               buffer_meters == other.buffer_meters && use_convex_hull == other.use_convex_hull &&
+               projection == other.projection;
+    }
+};
+
+class PolygonCache {
+public:
+    using Polygon = PolygonResult;
+
+    /** The process-wide cache used by the geometry functions. */
+    static PolygonCache& instance();
+
+    bool enabled() const { return capacity_.load(std::memory_order_relaxed) != 0; }
+
+    /** Copies the cached polygon into out and marks it most recently used; false on a miss. */
+    bool lookup(const PolygonCacheKey& key, Polygon& out);
+
+    /** Adds a polygon, evicting least recently used entries of its shard to make room. */
+    void insert(const PolygonCacheKey& key, const Polygon& polygon);
+
+    void set_capacity(size_t bytes);
+    void clear();
+    PolygonCacheStats stats();
+
+private:
+    static constexpr int kNumShards = 16;
+
+    struct KeyHash {
+        size_t operator()(const PolygonCacheKey& key) const;
+    };
+
+    struct Entry {
+        PolygonCacheKey key;
+        std::shared_ptr<const Polygon> polygon;
+        size_t bytes;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::list<Entry> lru;  // most recently used first
+        std::unordered_map<PolygonCacheKey, std::list<Entry>::iterator, KeyHash> index;
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    Shard& shard_for(const PolygonCacheKey& key);
+
+    /** Evicts from the back until the shard fits in budget bytes. Caller holds the lock. */
+    static void evict_to(Shard& shard, size_t budget);
+
+    std::atomic<size_t> capacity_{0};
+    Shard shards_[kNumShards];
+};
+
+} // namespace detail
+} // namespace h3_toolkit
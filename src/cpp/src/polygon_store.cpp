@@ -0,0 +1,460 @@
+/**
+ * @file polygon_store.cpp
+ * @brief Precomputed polygon stores: parallel, checkpointed generation and
+ *        memory-mapped lookup.
+ *
+ * Store layout (native byte order, every section 8-byte aligned), the
+ * PolygonBatch layout with the cells as keys:
+ *
+ *     StoreHeader                              80 bytes
+ *     H3Index  keys[count]                     sorted ascending
+ *     uint64_t polygon_offsets[count + 1]      polygon i is parts [polygon_offsets[i], polygon_offsets[i + 1])
+ *     uint64_t part_offsets[num_parts + 1]     part k is rings [part_offsets[k], part_offsets[k + 1])
+ *     uint64_t ring_offsets[num_rings + 1]     ring j is points [ring_offsets[j], ring_offsets[j + 1])
+ *     double   coords[2 * num_points]          lon, lat interleaved
+ *
+ * The checkpoint file starts with the same header (kCheckpointMagic, zero
+ * counts), followed by one record per finished cell in key order: cell and
+ * its numbers of points, rings and parts, the rings of each part, the
+ * points of each ring, then the coordinates.
+ */
+
+#include "h3_toolkit.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace h3_toolkit {
+
+namespace {
+
+constexpr char kStoreMagic[8] = {'H', '3', 'T', 'K', 'P', 'S', '0', '2'};
+constexpr char kCheckpointMagic[8] = {'H', '3', 'T', 'K', 'P', 'C', '0', '2'};
+constexpr uint32_t kVersion = 2;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t function;
+    int32_t cell_res;
+    int32_t target_res;
+    uint32_t use_convex_hull;
+    double buffer_meters;
+    uint64_t count;
+    uint64_t num_points;
+    uint32_t projection;
+    uint32_t reserved;
+    uint64_t num_rings;
+    uint64_t num_parts;
+};
+static_assert(sizeof(StoreHeader) == 80, "store header must stay 80 bytes");
+
+/** Checkpoint record header: cell, then the polygon's numbers of points, rings and parts. */
+struct RecordHeader {
+    uint64_t cell;
+    uint64_t num_points;
+    uint64_t num_rings;
+    uint64_t num_parts;
+
+    /** Bytes that follow this header. */
+    uint64_t payload_bytes() const {
+        return (num_parts + num_rings) * sizeof(uint64_t) + num_points * 2 * sizeof(double);
+    }
+};
+
+StoreHeader make_header(const char (&magic)[8], const PolygonStoreSpec& spec) {
+    StoreHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.function = static_cast<uint32_t>(spec.function);
+    header.cell_res = spec.cell_res;
+    header.target_res = spec.target_res;
+    header.use_convex_hull = spec.use_convex_hull ? 1 : 0;
+    header.projection = static_cast<uint32_t>(spec.projection);
+    // Every negative buffer means "auto"
+    header.buffer_meters = spec.buffer_meters < 0 ? -1.0 : spec.buffer_meters;
+    return header;
+}
+
+/** Header fields other than the counts, i.e. whether two files describe the same spec. */
+bool same_spec(const StoreHeader& a, const StoreHeader& b) {
+    return a.version == b.version && a.byte_order == b.byte_order && a.function == b.function &&
+           a.cell_res == b.cell_res && a.target_res == b.target_res &&
+           a.use_convex_hull == b.use_convex_hull && a.buffer_meters == b.buffer_meters &&
+           a.projection == b.projection;
+}
+
+/**
+ * Adds a section of count elements of elem_bytes to total, failing instead of
+ * overflowing once total would pass limit. Needs total <= limit.
+ */
+bool add_section(uint64_t& total, uint64_t count, uint64_t elem_bytes, uint64_t limit) {
+    if (count > (limit - total) / elem_bytes) {
+        return false;
+    }
+    total += count * elem_bytes;
+    return true;
+}
+
+/** Whether offsets[0..n] start at 0, never decrease and end at last. */
+bool valid_offsets(const uint64_t* offsets, uint64_t n, uint64_t last) {
+    if (offsets[0] != 0 || offsets[n] != last) {
+        return false;
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+        if (offsets[i + 1] < offsets[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PolygonResult compute_polygon(const PolygonStoreSpec& spec, H3Index cell) {
+    if (spec.function == StoredPolygon::BoundaryFromChildren) {
+        return cell_boundary_from_children(cell, spec.target_res);
+    }
+    return get_buffered_boundary_polygon(cell, spec.target_res, spec.buffer_meters, spec.use_convex_hull,
+                                         spec.projection);
+}
+
+/** Every cell of a resolution, sorted by index. */
+std::vector<H3Index> all_cells(int res) {
+    std::vector<H3Index> base(res0CellCount());
+    getRes0Cells(base.data());
+    int64_t total;
+    getNumCells(res, &total);
+    std::vector<H3Index> cells;
+    cells.reserve(static_cast<size_t>(total));
+    std::vector<H3Index> children;
+    for (H3Index b : base) {
+        int64_t size;
+        cellToChildrenSize(b, res, &size);
+        children.assign(static_cast<size_t>(size), 0);
+        cellToChildren(b, res, children.data());
+        for (H3Index child : children) {
+            if (child != H3_NULL) {
+                cells.push_back(child);
+            }
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+void write_or_throw(std::ostream& out, const void* data, size_t bytes, const std::string& path) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out) {
+        throw std::runtime_error("polygon store: write failed: " + path);
+    }
+}
+
+/**
+ * Reads the complete records of an existing checkpoint, checking that they
+ * follow 'cells' in order, and truncates a torn record left by an interrupted
+ * write. Returns the number of cells already done.
+ */
+size_t resume_checkpoint(const std::string& path, const StoreHeader& expected, const std::vector<H3Index>& cells) {
+    std::ifstream in(path, std::ios::binary);
+    StoreHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kCheckpointMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("polygon store: not a checkpoint file: " + path);
+    }
+    if (!same_spec(header, expected)) {
+        throw std::runtime_error("polygon store: checkpoint was written for a different spec: " + path);
+    }
+
+    size_t done = 0;
+    uint64_t valid_bytes = sizeof(header);
+    uint64_t file_bytes = fs::file_size(path);
+    for (;;) {
+        RecordHeader record;
+        if (!in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            break;
+        }
+        uint64_t record_bytes = sizeof(record) + record.payload_bytes();
+        if (done >= cells.size() || record.cell != cells[done]) {
+            throw std::runtime_error("polygon store: checkpoint records out of order: " + path);
+        }
+        if (valid_bytes + record_bytes > file_bytes) {
+            break;
+        }
+        in.seekg(static_cast<std::streamoff>(record.payload_bytes()), std::ios::cur);
+        valid_bytes += record_bytes;
+        ++done;
+    }
+    in.close();
+    if (valid_bytes != file_bytes) {
+        fs::resize_file(path, valid_bytes);
+    }
+    return done;
+}
+
+/** Turns a finished checkpoint into a store file at 'path'. */
+void assemble_store(const std::string& checkpoint, const std::string& path, StoreHeader header,
+                    const std::vector<H3Index>& cells) {
+    std::ifstream in(checkpoint, std::ios::binary);
+    in.seekg(sizeof(StoreHeader));
+
+    // First pass: the offsets
+    std::vector<uint64_t> polygon_offsets(cells.size() + 1, 0);
+    std::vector<uint64_t> part_offsets(1, 0);
+    std::vector<uint64_t> ring_offsets(1, 0);
+    std::vector<uint64_t> sizes;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        RecordHeader record;
+        if (!in.read(reinterpret_cast<char*>(&record), sizeof(record)) || record.cell != cells[i]) {
+            throw std::runtime_error("polygon store: checkpoint is incomplete: " + checkpoint);
+        }
+        sizes.resize(record.num_parts + record.num_rings);
+        in.read(reinterpret_cast<char*>(sizes.data()), static_cast<std::streamsize>(sizes.size() * sizeof(uint64_t)));
+        for (uint64_t k = 0; k < record.num_parts; ++k) {
+            part_offsets.push_back(part_offsets.back() + sizes[k]);
+        }
+        for (uint64_t j = 0; j < record.num_rings; ++j) {
+            ring_offsets.push_back(ring_offsets.back() + sizes[record.num_parts + j]);
+        }
+        polygon_offsets[i + 1] = polygon_offsets[i] + record.num_parts;
+        in.seekg(static_cast<std::streamoff>(record.num_points * 2 * sizeof(double)), std::ios::cur);
+    }
+    header.count = cells.size();
+    header.num_parts = part_offsets.size() - 1;
+    header.num_rings = ring_offsets.size() - 1;
+    header.num_points = ring_offsets.back();
+
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        write_or_throw(out, &header, sizeof(header), temp);
+        write_or_throw(out, cells.data(), cells.size() * sizeof(H3Index), temp);
+        write_or_throw(out, polygon_offsets.data(), polygon_offsets.size() * sizeof(uint64_t), temp);
+        write_or_throw(out, part_offsets.data(), part_offsets.size() * sizeof(uint64_t), temp);
+        write_or_throw(out, ring_offsets.data(), ring_offsets.size() * sizeof(uint64_t), temp);
+
+        // Second pass: copy the coordinates
+        in.clear();
+        in.seekg(sizeof(StoreHeader));
+        std::vector<double> coords;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            RecordHeader record;
+            in.read(reinterpret_cast<char*>(&record), sizeof(record));
+            in.seekg(static_cast<std::streamoff>((record.num_parts + record.num_rings) * sizeof(uint64_t)),
+                     std::ios::cur);
+            coords.resize(record.num_points * 2);
+            in.read(reinterpret_cast<char*>(coords.data()), static_cast<std::streamsize>(coords.size() * sizeof(double)));
+            write_or_throw(out, coords.data(), coords.size() * sizeof(double), temp);
+        }
+        out.close();
+        if (!out) {
+            throw std::runtime_error("polygon store: write failed: " + temp);
+        }
+    }
+    in.close();
+    fs::rename(temp, path);
+}
+
+} // namespace
+
+void build_polygon_store(const std::string& path, const PolygonStoreSpec& spec,
+                         const PolygonStoreBuildOptions& options) {
+    if (spec.cell_res < 0 || spec.target_res <= spec.cell_res || spec.target_res > 15) {
+        throw std::invalid_argument("target_res must be in (cell_res, 15]");
+    }
+    std::string checkpoint = options.checkpoint_path.empty() ? path + ".partial" : options.checkpoint_path;
+    size_t chunk_size = std::max<size_t>(options.chunk_size, 1);
+    StoreHeader header = make_header(kStoreMagic, spec);
+    StoreHeader checkpoint_header = make_header(kCheckpointMagic, spec);
+
+    std::vector<H3Index> cells = all_cells(spec.cell_res);
+    size_t done = 0;
+    if (fs::exists(checkpoint)) {
+        done = resume_checkpoint(checkpoint, header, cells);
+    } else {
+        std::ofstream out(checkpoint, std::ios::binary | std::ios::trunc);
+        write_or_throw(out, &checkpoint_header, sizeof(checkpoint_header), checkpoint);
+    }
+
+    std::ofstream out(checkpoint, std::ios::binary | std::ios::app);
+    if (!out) {
+        throw std::runtime_error("polygon store: cannot open checkpoint: " + checkpoint);
+    }
+    std::vector<PolygonResult> polygons;
+    std::vector<uint64_t> sizes;
+    while (done < cells.size()) {
+        size_t n = std::min(chunk_size, cells.size() - done);
+        polygons.assign(n, PolygonResult());
+        detail::ThreadPool::shared().parallel_for(n, [&](size_t i) {
+            polygons[i] = compute_polygon(spec, cells[done + i]);
+        }, options.num_threads);
+
+        for (size_t i = 0; i < n; ++i) {
+            const PolygonResult& polygon = polygons[i];
+            RecordHeader record = {cells[done + i], polygon.num_points(), polygon.num_rings(), polygon.num_parts()};
+            sizes.clear();
+            for (size_t k = 0; k < polygon.num_parts(); ++k) {
+                sizes.push_back(polygon.part_offsets[k + 1] - polygon.part_offsets[k]);
+            }
+            for (size_t j = 0; j < polygon.num_rings(); ++j) {
+                sizes.push_back(polygon.ring_offsets[j + 1] - polygon.ring_offsets[j]);
+            }
+            write_or_throw(out, &record, sizeof(record), checkpoint);
+            write_or_throw(out, sizes.data(), sizes.size() * sizeof(uint64_t), checkpoint);
+            write_or_throw(out, polygon.coords.data(), polygon.coords.size() * sizeof(double), checkpoint);
+        }
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("polygon store: write failed: " + checkpoint);
+        }
+        done += n;
+        if (options.progress) {
+            options.progress(done, cells.size());
+        }
+    }
+    out.close();
+
+    assemble_store(checkpoint, path, header, cells);
+    fs::remove(checkpoint);
+}
+
+struct PolygonStore::Mapping {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::vector<unsigned char> buffer;
+#else
+    ~Mapping() {
+        if (data) {
+            munmap(const_cast<unsigned char*>(data), size);
+        }
+    }
+#endif
+};
+
+PolygonStore::PolygonStore(const std::string& path) : mapping_(new Mapping) {
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("polygon store: cannot open " + path);
+    }
+    mapping_->buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    mapping_->data = mapping_->buffer.data();
+    mapping_->size = mapping_->buffer.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("polygon store: cannot open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(StoreHeader))) {
+        ::close(fd);
+        throw std::runtime_error("polygon store: not a polygon store: " + path);
+    }
+    void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("polygon store: mmap failed: " + path);
+    }
+    mapping_->data = static_cast<const unsigned char*>(data);
+    mapping_->size = static_cast<size_t>(st.st_size);
+#endif
+
+    StoreHeader header;
+    if (mapping_->size < sizeof(header)) {
+        throw std::runtime_error("polygon store: not a polygon store: " + path);
+    }
+    std::memcpy(&header, mapping_->data, sizeof(header));
+    if (std::memcmp(header.magic, kStoreMagic, sizeof(header.magic)) != 0 || header.version != kVersion) {
+        throw std::runtime_error("polygon store: not a polygon store: " + path);
+    }
+    if (header.byte_order != kByteOrderMark) {
+        throw std::runtime_error("polygon store: written with a different byte order: " + path);
+    }
+    // Every section must fit the file exactly; counts are checked before they
+    // are multiplied, so a corrupt header cannot overflow the sum
+    uint64_t limit = mapping_->size;
+    uint64_t expected = sizeof(header);
+    bool fits = add_section(expected, header.count, sizeof(H3Index), limit) &&
+                add_section(expected, header.count, sizeof(uint64_t), limit) &&
+                add_section(expected, header.num_parts, sizeof(uint64_t), limit) &&
+                add_section(expected, header.num_rings, sizeof(uint64_t), limit) &&
+                add_section(expected, 3, sizeof(uint64_t), limit) &&
+                add_section(expected, header.num_points, 2 * sizeof(double), limit);
+    if (!fits || expected != limit) {
+        throw std::runtime_error("polygon store: truncated or corrupt: " + path);
+    }
+    if (header.function > static_cast<uint32_t>(StoredPolygon::BufferedBoundary) ||
+        header.projection > static_cast<uint32_t>(BufferProjection::LocalAzimuthalEquidistant) ||
+        header.cell_res < 0 || header.cell_res > 15 || header.target_res < 0 || header.target_res > 15) {
+        throw std::runtime_error("polygon store: invalid spec: " + path);
+    }
+
+    spec_.function = static_cast<StoredPolygon>(header.function);
+    spec_.cell_res = header.cell_res;
+    spec_.target_res = header.target_res;
+    spec_.buffer_meters = header.buffer_meters;
+    spec_.use_convex_hull = header.use_convex_hull != 0;
+    spec_.projection = static_cast<BufferProjection>(header.projection);
+    count_ = static_cast<size_t>(header.count);
+    keys_ = reinterpret_cast<const H3Index*>(mapping_->data + sizeof(header));
+    polygon_offsets_ = reinterpret_cast<const uint64_t*>(keys_ + count_);
+    part_offsets_ = polygon_offsets_ + count_ + 1;
+    ring_offsets_ = part_offsets_ + header.num_parts + 1;
+    coords_ = reinterpret_cast<const double*>(ring_offsets_ + header.num_rings + 1);
+    // find() indexes by these without further checks: keys must be sorted and
+    // every offset array must climb from 0 to the next level's count
+    bool sorted = std::adjacent_find(keys_, keys_ + count_, std::greater_equal<H3Index>()) == keys_ + count_;
+    if (!sorted || !valid_offsets(polygon_offsets_, count_, header.num_parts) ||
+        !valid_offsets(part_offsets_, header.num_parts, header.num_rings) ||
+        !valid_offsets(ring_offsets_, header.num_rings, header.num_points)) {
+        throw std::runtime_error("polygon store: truncated or corrupt: " + path);
+    }
+}
+
+PolygonStore::~PolygonStore() = default;
+PolygonStore::PolygonStore(PolygonStore&&) noexcept = default;
+PolygonStore& PolygonStore::operator=(PolygonStore&&) noexcept = default;
+
+PolygonView PolygonStore::find(H3Index cell) const {
+    const H3Index* end = keys_ + count_;
+    const H3Index* it = std::lower_bound(keys_, end, cell);
+    if (it == end || *it != cell) {
+        return {};
+    }
+    size_t i = static_cast<size_t>(it - keys_);
+    PolygonView view;
+    view.part_offsets = part_offsets_ + polygon_offsets_[i];
+    view.num_parts = static_cast<size_t>(polygon_offsets_[i + 1] - polygon_offsets_[i]);
+    view.ring_offsets = ring_offsets_ + view.part_offsets[0];
+    view.num_rings = static_cast<size_t>(view.part_offsets[view.num_parts] - view.part_offsets[0]);
+    view.coords = coords_ + 2 * view.ring_offsets[0];
+    view.num_points = static_cast<size_t>(view.ring_offsets[view.num_rings] - view.ring_offsets[0]);
+    return view;
+}
+
+PolygonResult PolygonStore::polygon(H3Index cell) const {
+    PolygonView view = find(cell);
+    if (!view) {
+        return compute_polygon(spec_, cell);
+    }
+    return view.to_result();
+}
+
+} // namespace h3_toolkit
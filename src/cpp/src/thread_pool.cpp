@@ -0,0 +1,196 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Work-stealing thread pool behind the parallel entry points.
+ */
+
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace h3_toolkit {
+namespace detail {
+
+namespace {
+
+thread_local bool t_inside_task = false;
+
+} // namespace
+
+/** One participant's share of a job; the owner pops the front, thieves the back. */
+struct alignas(64) TaskRange {
+    std::mutex mutex;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+struct ThreadPool::Job {
+    const std::function<void(size_t)>* task = nullptr;
+    std::unique_ptr<TaskRange[]> ranges;
+    int participants = 0;
+    std::atomic<size_t> remaining{0};
+    std::atomic<int> active{0};
+    std::mutex done_mutex;
+    std::condition_variable done;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(int num_workers) {
+    for (int i = 0; i < num_workers; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i + 1); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1);
+    return pool;
+}
+
+int resolve_num_threads(int num_threads) {
+    int max_threads = ThreadPool::shared().max_threads();
+    return (num_threads <= 0 || num_threads > max_threads) ? max_threads : num_threads;
+}
+
+void ThreadPool::participate(Job& job, int slot) {
+    auto run = [&](size_t i) {
+        t_inside_task = true;
+        try {
+            (*job.task)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.error_mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+        t_inside_task = false;
+        if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(job.done_mutex);
+            job.done.notify_all();
+        }
+    };
+
+    TaskRange& own = job.ranges[slot];
+    for (;;) {
+        size_t i;
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin == own.end) {
+                break;
+            }
+            i = own.begin++;
+        }
+        run(i);
+    }
+
+    // Own range is empty: steal from the back of the others until all are empty.
+    for (bool found = true; found;) {
+        found = false;
+        for (int k = 1; k < job.participants; ++k) {
+            TaskRange& victim = job.ranges[(slot + k) % job.participants];
+            size_t i;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin == victim.end) {
+                    continue;
+                }
+                i = --victim.end;
+            }
+            run(i);
+            found = true;
+        }
+    }
+}
+
+void ThreadPool::worker_loop(int slot) {
+    size_t seen = 0;
+    for (;;) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            job = job_;
+            if (!job || slot >= job->participants) {
+                continue;
+            }
+            job->active.fetch_add(1, std::memory_order_relaxed);
+        }
+        participate(*job, slot);
+        // Decrement under the lock: once active hits zero the caller may
+        // destroy the job, so this must be the last access to it.
+        std::lock_guard<std::mutex> lock(job->done_mutex);
+        if (job->active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            job->done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::parallel_for(size_t num_tasks, const std::function<void(size_t)>& task, int num_threads) {
+    if (num_tasks == 0) {
+        return;
+    }
+    int participants = (num_threads <= 0 || num_threads > max_threads()) ? max_threads() : num_threads;
+    participants = static_cast<int>(std::min<size_t>(participants, num_tasks));
+    if (participants <= 1 || t_inside_task) {
+        for (size_t i = 0; i < num_tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+    Job job;
+    job.task = &task;
+    job.participants = participants;
+    job.ranges.reset(new TaskRange[participants]);
+    for (int p = 0; p < participants; ++p) {
+        job.ranges[p].begin = num_tasks * p / participants;
+        job.ranges[p].end = num_tasks * (p + 1) / participants;
+    }
+    job.remaining.store(num_tasks, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    participate(job, 0);
+
+    // Wait for every task to finish and every worker to let go of the job
+    // before it goes out of scope.
+    {
+        std::unique_lock<std::mutex> lock(job.done_mutex);
+        job.done.wait(lock, [&] {
+            return job.remaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = nullptr;
+    }
+    {
+        std::unique_lock<std::mutex> lock(job.done_mutex);
+        job.done.wait(lock, [&] { return job.active.load(std::memory_order_acquire) == 0; });
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+} // namespace detail
+} // namespace h3_toolkit
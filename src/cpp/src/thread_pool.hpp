@@ -0,0 +1,73 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Small work-stealing thread pool shared by the parallel entry points.
+ *
+ * Internal header; nothing in here is part of the public API.
+ *
+ * parallel_for splits [0, num_tasks) into one contiguous range per
+ * participant (the calling thread included). Each participant consumes its
+ * own range from the front and, once it runs dry, steals single tasks from
+ * the back of the others' ranges, so uneven task costs even out without a
+ * central queue.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace h3_toolkit {
+namespace detail {
+
+class ThreadPool {
+public:
+    /** Starts num_workers background threads (the caller is an extra participant). */
+    explicit ThreadPool(int num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Maximum number of threads a parallel_for can use, caller included. */
+    int max_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * Runs task(i) for every i in [0, num_tasks) and returns once all are
+     * done. Uses up to num_threads threads (0 = all); the caller takes part.
+     * The first exception thrown by a task is rethrown here after the
+     * remaining tasks finish.
+     *
+     * Calls from inside a task run serially on the calling thread, and
+     * concurrent calls from different threads take turns.
+     */
+    void parallel_for(size_t num_tasks, const std::function<void(size_t)>& task, int num_threads = 0);
+
+    /** Process-wide pool sized to the hardware concurrency. */
+    static ThreadPool& shared();
+
+private:
+    struct Job;
+
+    void worker_loop(int slot);
+    static void participate(Job& job, int slot);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::mutex submit_mutex_;
+    Job* job_ = nullptr;
+    size_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+/** Resolves a user-facing thread count (<= 0 meaning "all") against the shared pool. */
+int resolve_num_threads(int num_threads);
+
+} // namespace detail
+} // namespace h3_toolkit
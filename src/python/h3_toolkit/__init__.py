@@ -35,6 +35,22 @@ Available Functions:
         - cell_boundary_from_children / cell_boundary_from_children_cpp
         - get_buffered_h3_polygon / get_buffered_h3_polygon_cpp
         - get_buffered_boundary_polygon / get_buffered_boundary_polygon_cpp
+        - get_containment_polygon_cpp (C++ only): containment within a vertex budget
+        - max_descendant_overhang: the table behind the automatic buffers
+        The _cpp versions return GeoJSON Polygon or, for several parts,
+        MultiPolygon features; the raw bindings return PolygonResult
+        (coords, ring_offsets and part_offsets as numpy views).
+
+    Batch geometry (C++ only, numpy arrays in CSR form: polygons, parts, rings):
+        - cell_boundaries, cell_boundaries_from_children
+        - get_buffered_h3_polygons, get_buffered_boundary_polygons
+
+    Polygon cache (C++ geometry only):
+        - set_polygon_cache_capacity(bytes): LRU budget, 0 = disabled (default)
+        - clear_polygon_cache()
+        - polygon_cache_stats(): hits, misses, evictions, entries, bytes
+        - PolygonStore(path): memory-mapped precomputed polygons
+          (generated with the build_polygon_store tool)
 
     Utilities:
         - get_backend(): Returns 'cpp' or 'python'
@@ -71,22 +87,32 @@ from .geom import (
     get_boundary_cells,
     cell_boundary_from_children,
     get_buffered_h3_polygon,          # Pure Python/Shapely
-    get_buffered_boundary_polygon     # Pure Python/Shapely
+    get_buffered_boundary_polygon,    # Pure Python/Shapely
+    max_descendant_overhang           # Replaced by the C++ version when available
 )
 
 # C++ geometry wrapper (returns GeoJSON like Python version)
 _CPP_GEOM_AVAILABLE = False
 try:
     from ._h3_toolkit_cpp import get_buffered_boundary_polygon as _cpp_buffered_polygon
+    from ._h3_toolkit_cpp import BufferProjection, PolygonResult, max_descendant_overhang
     import h3
     import geojson as _geojson
     _CPP_GEOM_AVAILABLE = True
+
+    def _to_geometry(result):
+        """GeoJSON Polygon of a one-part PolygonResult, MultiPolygon otherwise; holes kept."""
+        parts = [[[[x, y] for x, y in ring] for ring in part] for part in result.coordinates()]
+        if len(parts) == 1:
+            return _geojson.Polygon(parts[0])
+        return _geojson.MultiPolygon(parts)
     
     def get_buffered_boundary_polygon_cpp(
         cell: str, 
         intermediate_res: int = 10, 
         buffer_meters: float = None,
-        use_convex_hull: bool = False
+        use_convex_hull: bool = False,
+        projection: "BufferProjection" = BufferProjection.Degrees
     ):
         """
         C++ buffered polygon using Boost.Geometry.
@@ -96,8 +122,13 @@ try:
         Args:
             cell: H3 cell index
             intermediate_res: Resolution for boundary computation (default 10)
-            buffer_meters: Buffer in meters. If None, auto-calculates as 100% of edge length.
+            buffer_meters: Buffer in meters. If None, the furthest the res-15
+                descendants of the intermediate children reach outside them
+                (max_descendant_overhang).
             use_convex_hull: True = fast convex hull, False = accurate merged boundary (default)
+            projection: BufferProjection.Degrees buffers in lon/lat (default);
+                BufferProjection.LocalAzimuthalEquidistant buffers in meters about
+                the cell center, equally far in every direction at any latitude
         
         Returns:
             GeoJSON Feature with buffered polygon
@@ -107,16 +138,14 @@ try:
         
         # C++ uses -1.0 to mean auto-calculate
         cpp_buffer = buffer_meters if buffer_meters is not None else -1.0
-        coords = _cpp_buffered_polygon(cell, int_res, cpp_buffer, use_convex_hull)
+        result = _cpp_buffered_polygon(cell, int_res, cpp_buffer, use_convex_hull, projection)
         
         # Wrap in GeoJSON format
-        geojson_coords = [[c[0], c[1]] for c in coords]
-        polygon = _geojson.Polygon([geojson_coords])
+        polygon = _to_geometry(result)
         
         # Calculate actual buffer for properties
         if buffer_meters is None:
-            edge_km = h3.average_hexagon_edge_length(int_res, unit='km')
-            actual_buffer = edge_km * 1000 * 1.0
+            actual_buffer = max_descendant_overhang(int_res, 15)
         else:
             actual_buffer = buffer_meters
         
@@ -136,12 +165,20 @@ try:
     from ._h3_toolkit_cpp import cell_boundary as _cpp_cell_boundary
     from ._h3_toolkit_cpp import cell_boundary_from_children as _cpp_cell_boundary_from_children
     from ._h3_toolkit_cpp import get_buffered_h3_polygon as _cpp_get_buffered_h3_polygon
+    from ._h3_toolkit_cpp import (
+        set_polygon_cache_capacity,
+        clear_polygon_cache,
+        polygon_cache_stats,
+        PolygonStore,
+        cell_boundaries,
+        cell_boundaries_from_children,
+        get_buffered_h3_polygons,
+        get_buffered_boundary_polygons
+    )
     
     def cell_boundary_to_geojson_cpp(cell: str):
         """C++ version of cell_boundary_to_geojson. Returns GeoJSON Feature."""
-        coords = _cpp_cell_boundary(cell)
-        geojson_coords = [[c[0], c[1]] for c in coords]
-        polygon = _geojson.Polygon([geojson_coords])
+        polygon = _to_geometry(_cpp_cell_boundary(cell))
         return _geojson.Feature(geometry=polygon, properties={"h3_index": cell, "method": "cpp"})
     
     def cell_boundary_from_children_cpp(parent: str, target_res: int):
@@ -150,9 +187,7 @@ try:
         boundary_children = children_on_boundary_faces(parent, target_res)
         num_cells = len(boundary_children)
         
-        coords = _cpp_cell_boundary_from_children(parent, target_res)
-        geojson_coords = [[c[0], c[1]] for c in coords]
-        polygon = _geojson.Polygon([geojson_coords])
+        polygon = _to_geometry(_cpp_cell_boundary_from_children(parent, target_res))
         return _geojson.Feature(
             geometry=polygon,
             properties={
@@ -163,18 +198,17 @@ try:
             }
         )
     
-    def get_buffered_h3_polygon_cpp(cell: str, buffer_meters: float = None):
+    def get_buffered_h3_polygon_cpp(
+        cell: str,
+        buffer_meters: float = None,
+        projection: "BufferProjection" = BufferProjection.Degrees
+    ):
         """C++ version of get_buffered_h3_polygon. Returns GeoJSON Feature."""
         cpp_buffer = buffer_meters if buffer_meters is not None else -1.0
-        coords = _cpp_get_buffered_h3_polygon(cell, cpp_buffer)
-        geojson_coords = [[c[0], c[1]] for c in coords]
-        polygon = _geojson.Polygon([geojson_coords])
+        polygon = _to_geometry(_cpp_get_buffered_h3_polygon(cell, cpp_buffer, projection))
         
         if buffer_meters is None:
-            res = h3.get_resolution(cell)
-            int_res = min(res + 4, 15)
-            edge_km = h3.average_hexagon_edge_length(int_res, unit='km')
-            actual_buffer = edge_km * 1000 * 1.0
+            actual_buffer = max_descendant_overhang(h3.get_resolution(cell), 15, h3.is_pentagon(cell))
         else:
             actual_buffer = buffer_meters
         
@@ -186,6 +220,35 @@ try:
                 "method": "buffered_cpp"
             }
         )
+    
+    from ._h3_toolkit_cpp import get_containment_polygon as _cpp_get_containment_polygon
+    
+    def get_containment_polygon_cpp(
+        cell: str,
+        max_vertices: int = 32,
+        max_inflation: float = 1.25,
+        buffer_meters: float = None
+    ):
+        """
+        Convex polygon containing all res-15 children in at most max_vertices
+        vertices. Returns GeoJSON Feature; properties report the inflation
+        (area over the cell's area) and whether it is within max_inflation.
+        """
+        cpp_buffer = buffer_meters if buffer_meters is not None else -1.0
+        result = _cpp_get_containment_polygon(cell, max_vertices, max_inflation, cpp_buffer)
+        polygon = _to_geometry(result["polygon"])
+        return _geojson.Feature(
+            geometry=polygon,
+            properties={
+                "h3_index": cell,
+                "vertex_count": result["vertex_count"],
+                "inflation": result["inflation"],
+                "within_budget": result["within_budget"],
+                "intermediate_res": result["intermediate_res"],
+                "buffer_meters": result["buffer_meters"],
+                "method": "containment_cpp"
+            }
+        )
         
 except ImportError:
     pass
@@ -0,0 +1,45 @@
+"""
+Generated by tools/generate_overhang_table.cpp --python (safety factor 1.10). Do not edit.
+
+DESCENDANT_OVERHANG_M[pentagon][res][descendant_res]: the same table as
+src/cpp/src/overhang_table.hpp, for the pure-Python backend.
+"""
+
+DESCENDANT_OVERHANG_M = (
+    (  # Hexagons
+        (0, 191204, 191204, 218519, 218519, 222421, 222421, 222979, 222979, 223058, 223058, 223070, 223070, 223071, 223071, 223072),  # res 0
+        (0, 0, 72268.4, 72268.4, 82592.5, 82592.5, 84067.3, 84067.3, 84278, 84278, 84308.1, 84308.1, 84312.4, 84312.4, 84313, 84313),  # res 1
+        (0, 0, 0, 27314.9, 27314.9, 31217, 31217, 31774.5, 31774.5, 31854.1, 31854.1, 31865.5, 31865.5, 31867.1, 31867.1, 31867.3),  # res 2
+        (0, 0, 0, 0, 10324.1, 10324.1, 11798.9, 11798.9, 12009.6, 12009.6, 12039.7, 12039.7, 12044, 12044, 12044.6, 12044.6),  # res 3
+        (0, 0, 0, 0, 0, 3902.13, 3902.13, 4459.57, 4459.57, 4539.21, 4539.21, 4550.59, 4550.59, 4552.21, 4552.21, 4552.44),  # res 4
+        (0, 0, 0, 0, 0, 0, 1474.87, 1474.87, 1685.56, 1685.56, 1715.66, 1715.66, 1719.96, 1719.96, 1720.57, 1720.57),  # res 5
+        (0, 0, 0, 0, 0, 0, 0, 557.447, 557.447, 637.082, 637.082, 648.458, 648.458, 650.084, 650.084, 650.316),  # res 6
+        (0, 0, 0, 0, 0, 0, 0, 0, 210.695, 210.695, 240.794, 240.794, 245.094, 245.094, 245.709, 245.709),  # res 7
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 79.6352, 79.6352, 91.0117, 91.0117, 92.6369, 92.6369, 92.8691),  # res 8
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 30.0993, 30.0993, 34.3992, 34.3992, 35.0135, 35.0135),  # res 9
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11.3765, 11.3765, 13.0017, 13.0017, 13.2338),  # res 10
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4.2999, 4.2999, 4.91417, 4.91417),  # res 11
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1.62521, 1.62521, 1.85738),  # res 12
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.614271, 0.614271),  # res 13
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.232173),  # res 14
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0),  # res 15
+    ),
+    (  # Pentagons
+        (0, 176111, 176111, 201269, 201269, 204864, 204864, 205377, 205377, 205450, 205450, 205461, 205461, 205462, 205462, 205463),  # res 0
+        (0, 0, 61345.6, 61345.6, 70109.3, 70109.3, 71361.2, 71361.2, 71540.1, 71540.1, 71565.6, 71565.6, 71569.3, 71569.3, 71569.8, 71569.8),  # res 1
+        (0, 0, 0, 22289.5, 22289.5, 25473.7, 25473.7, 25928.6, 25928.6, 25993.5, 25993.5, 26002.8, 26002.8, 26004.1, 26004.1, 26004.3),  # res 2
+        (0, 0, 0, 0, 8288.69, 8288.69, 9472.79, 9472.79, 9641.95, 9641.95, 9666.11, 9666.11, 9669.57, 9669.57, 9670.06, 9670.06),  # res 3
+        (0, 0, 0, 0, 0, 3113, 3113, 3557.72, 3557.72, 3621.25, 3621.25, 3630.32, 3630.32, 3631.62, 3631.62, 3631.8),  # res 4
+        (0, 0, 0, 0, 0, 0, 1173.75, 1173.75, 1341.43, 1341.43, 1365.38, 1365.38, 1368.8, 1368.8, 1369.29, 1369.29),  # res 5
+        (0, 0, 0, 0, 0, 0, 0, 443.226, 443.226, 506.544, 506.544, 515.59, 515.59, 516.882, 516.882, 517.067),  # res 6
+        (0, 0, 0, 0, 0, 0, 0, 0, 167.465, 167.465, 191.389, 191.389, 194.807, 194.807, 195.295, 195.295),  # res 7
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 63.2876, 63.2876, 72.3287, 72.3287, 73.6202, 73.6202, 73.8048),  # res 8
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23.9193, 23.9193, 27.3363, 27.3363, 27.8244, 27.8244),  # res 9
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9.04046, 9.04046, 10.332, 10.332, 10.5165),  # res 10
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3.41695, 3.41695, 3.90508, 3.90508),  # res 11
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1.29148, 1.29148, 1.47598),  # res 12
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.488134, 0.488134),  # res 13
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.184497),  # res 14
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0),  # res 15
+    ),
+)
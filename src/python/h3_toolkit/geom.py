@@ -10,6 +10,7 @@ Functions:
     - cell_boundary_from_children: Merge boundary children into polygon
     - get_buffered_h3_polygon: Buffer a cell's native boundary
     - get_buffered_boundary_polygon: Buffer boundary children polygon
+    - max_descendant_overhang: The automatic buffer distance
 
 All functions return GeoJSON-compatible output for easy visualization with
 libraries like Folium, Leaflet, or Mapbox.
@@ -18,10 +19,36 @@ Note: For better performance, use the C++ versions (*_cpp suffix) when available
 """
 import h3
 import geojson
-from math import cos, radians
+from math import cos, pi, radians
 from typing import Set, Dict, Any, List, Tuple
 from shapely.geometry import Polygon, shape
 
+from ._overhang_table import DESCENDANT_OVERHANG_M
+
+_EARTH_RADIUS_M = 6371007.180918475  # h3lib's EARTH_RADIUS_KM
+
+
+def max_descendant_overhang(res: int, descendant_res: int, pentagon: bool = False) -> float:
+    """
+    The furthest, in meters, that any descendant at descendant_res reaches
+    outside its ancestor cell at res. Same table as the C++ version.
+    """
+    if res < 0 or descendant_res < res or descendant_res > 15:
+        raise ValueError("need 0 <= res <= descendant_res <= 15")
+    return DESCENDANT_OVERHANG_M[1 if pentagon else 0][res][descendant_res]
+
+
+def _auto_buffer_degrees(coords, buffer_meters: float) -> float:
+    """
+    Degrees that reach at least buffer_meters in every direction around the
+    (lon, lat) coords: the longitude scale at the furthest latitude from the
+    equator the buffer can reach, as in the C++ auto buffers.
+    """
+    meters_per_degree = _EARTH_RADIUS_M * pi / 180
+    max_lat = max(abs(c[1]) for c in coords)
+    lat_scale = min(max_lat + buffer_meters / meters_per_degree, 89.0)
+    return buffer_meters / (meters_per_degree * cos(radians(lat_scale)))
+
 # Import from package level to use C++ binding when available
 def _get_children_on_boundary_faces():
     try:
@@ -186,19 +213,13 @@ def get_buffered_h3_polygon(cell: str, buffer_meters: float = None) -> Dict[str,
     
     Args:
         cell: H3 cell index
-        buffer_meters: Buffer distance in meters. If None, auto-calculated as
-                      100% of intermediate resolution edge length.
+        buffer_meters: Buffer distance in meters. If None, the overhang of the
+                      cell's res 15 descendants (max_descendant_overhang).
                       
     Returns:
         GeoJSON Feature with the buffered polygon
     """
     res = h3.get_resolution(cell)
-    intermediate_res = min(res + 4, 15)  # Use res+4 for buffer calculation
-    
-    # Auto-calculate buffer as 100% of intermediate edge length
-    if buffer_meters is None:
-        edge_km = h3.average_hexagon_edge_length(intermediate_res, unit='km')
-        buffer_meters = edge_km * 1000 * 1.0
     
     # Get the cell boundary
     boundary = h3.cell_to_boundary(cell)
@@ -206,13 +227,18 @@ def get_buffered_h3_polygon(cell: str, buffer_meters: float = None) -> Dict[str,
     
     poly = Polygon(coords)
     
-    # Convert buffer from meters to degrees (approximate)
-    lat = boundary[0][0]
-    meters_per_degree_lat = 111320
-    meters_per_degree_lon = 111320 * abs(cos(radians(lat)))
-    
-    avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2
-    buffer_degrees = buffer_meters / avg_meters_per_degree
+    # Auto: just enough to cover the res 15 descendants
+    if buffer_meters is None:
+        buffer_meters = max_descendant_overhang(res, 15, h3.is_pentagon(cell))
+        buffer_degrees = _auto_buffer_degrees(coords, buffer_meters)
+    else:
+        # Convert buffer from meters to degrees (approximate)
+        lat = boundary[0][0]
+        meters_per_degree_lat = 111320
+        meters_per_degree_lon = 111320 * abs(cos(radians(lat)))
+        
+        avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2
+        buffer_degrees = buffer_meters / avg_meters_per_degree
     
     buffered = poly.buffer(buffer_degrees)
     
@@ -245,8 +271,8 @@ def get_buffered_boundary_polygon(
         cell: H3 cell index
         intermediate_res: Resolution to compute actual boundary (default 10).
                          Must be >= cell resolution.
-        buffer_meters: Additional buffer in meters. If None, auto-calculated based
-                      on difference between intermediate_res and res 15.
+        buffer_meters: Additional buffer in meters. If None, the overhang of the
+                      intermediate children's res 15 descendants (max_descendant_overhang).
                       
     Returns:
         GeoJSON Feature with the buffered boundary polygon
@@ -264,23 +290,22 @@ def get_buffered_boundary_polygon(
     if intermediate_res >= 15 or buffer_meters == 0:
         return boundary_geojson
     
-    # Auto-calculate buffer based on intermediate resolution edge length
-    if buffer_meters is None:
-        edge_km = h3.average_hexagon_edge_length(intermediate_res, unit='km')
-        # Buffer by 100% of intermediate cell edge length for safety
-        buffer_meters = edge_km * 1000 * 1.0
-    
     # Convert GeoJSON to Shapely polygon
     coords = boundary_geojson['geometry']['coordinates'][0]
     poly = Polygon([(c[0], c[1]) for c in coords])
     
-    # Convert buffer from meters to degrees
-    centroid = poly.centroid
-    lat = centroid.y
-    meters_per_degree_lat = 111320
-    meters_per_degree_lon = 111320 * abs(cos(radians(lat)))
-    avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2
-    buffer_degrees = buffer_meters / avg_meters_per_degree
+    # Auto: the overhang of the intermediate children's res 15 descendants
+    if buffer_meters is None:
+        buffer_meters = max_descendant_overhang(intermediate_res, 15)
+        buffer_degrees = _auto_buffer_degrees(coords, buffer_meters)
+    else:
+        # Convert buffer from meters to degrees
+        centroid = poly.centroid
+        lat = centroid.y
+        meters_per_degree_lat = 111320
+        meters_per_degree_lon = 111320 * abs(cos(radians(lat)))
+        avg_meters_per_degree = (meters_per_degree_lat + meters_per_degree_lon) / 2
+        buffer_degrees = buffer_meters / avg_meters_per_degree
     
     # Apply buffer
     buffered = poly.buffer(buffer_degrees)
@@ -1,8 +1,18 @@
 #include "h3_toolkit.hpp"
+#include "thread_pool.hpp"
 #include <h3api.h>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <set>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 void test_trace_to_parent() {
@@ -38,10 +48,1250 @@ void test_trace_to_ancestor() {
     std::cout << "Trace to ancestor (res 4) result size: " << result.size() << std::endl;
 }
 
+void test_boundary_children_trace_back() {
+    // Every boundary child must trace back onto at least one parent face.
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 5, &parent);
+
+    std::set<int> all_faces = {1, 2, 3, 4, 5, 6};
+    auto children = h3_toolkit::children_on_boundary_faces(parent, 8, all_faces);
+    assert(!children.empty());
+    for (H3Index child : children) {
+        assert(!h3_toolkit::trace_cell_to_ancestor_faces(child, all_faces, 5).empty());
+    }
+    std::cout << "Boundary children traced back: " << children.size() << std::endl;
+}
+
+void test_face_mask_overloads() {
+    using h3_toolkit::FaceMask;
+    assert(h3_toolkit::to_face_mask({1, 3}) == (h3_toolkit::face_bit(1) | h3_toolkit::face_bit(3)));
+    assert(h3_toolkit::to_face_set(FaceMask::All) == std::set<int>({1, 2, 3, 4, 5, 6}));
+    assert(h3_toolkit::face_count(~h3_toolkit::face_bit(2)) == 5);
+
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 5, &parent);
+
+    // Mask and set overloads must agree
+    auto children = h3_toolkit::children_on_boundary_faces(parent, 8, h3_toolkit::face_bit(2) | h3_toolkit::face_bit(5));
+    assert(children == h3_toolkit::children_on_boundary_faces(parent, 8, std::set<int>{2, 5}));
+    for (H3Index child : children) {
+        FaceMask faces = h3_toolkit::trace_cell_to_ancestor_faces(child, FaceMask::All, 5);
+        assert(h3_toolkit::to_face_set(faces) == h3_toolkit::trace_cell_to_ancestor_faces(child, {1, 2, 3, 4, 5, 6}, 5));
+        assert(h3_toolkit::cell_to_coarsest_ancestor_on_faces(child, FaceMask::All) ==
+               h3_toolkit::cell_to_coarsest_ancestor_on_faces(child));
+    }
+    std::cout << "FaceMask overloads agree on " << children.size() << " cells" << std::endl;
+}
+
+void test_batch_trace() {
+    using h3_toolkit::FaceMask;
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 5, &parent);
+
+    std::vector<H3Index> cells = h3_toolkit::children_on_boundary_faces(parent, 8, FaceMask::All);
+    cells.push_back(parent);   // res_parent == cell res -> E_RES_DOMAIN
+    cells.push_back(0);        // not a cell -> E_CELL_INVALID
+
+    std::vector<FaceMask> faces(cells.size());
+    std::vector<H3Error> status(cells.size());
+    h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), cells.size(), FaceMask::All, 5,
+                                              faces.data(), status.data());
+    for (size_t i = 0; i + 2 < cells.size(); ++i) {
+        assert(status[i] == E_SUCCESS);
+        assert(faces[i] == h3_toolkit::trace_cell_to_ancestor_faces(cells[i], FaceMask::All, 5));
+    }
+    assert(status[cells.size() - 2] == E_RES_DOMAIN);
+    assert(status[cells.size() - 1] == E_CELL_INVALID);
+    assert(faces[cells.size() - 1] == FaceMask::None);
+
+    // Per-element form, status array omitted
+    std::vector<FaceMask> inputs(cells.size() - 2, h3_toolkit::face_bit(3));
+    std::vector<int> res_parents(cells.size() - 2, 6);
+    h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), inputs.size(), inputs.data(), res_parents.data(),
+                                              faces.data(), nullptr);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        assert(faces[i] == h3_toolkit::trace_cell_to_ancestor_faces(cells[i], inputs[i], 6));
+    }
+    std::cout << "Batch trace agrees on " << inputs.size() << " cells" << std::endl;
+}
+
+void test_batch_trace_simd_levels() {
+    using h3_toolkit::FaceMask;
+    using h3_toolkit::SimdLevel;
+
+    // Mixed input: boundary and interior cells at several resolutions, cells
+    // under a pentagon, invalid indexes, and a length that leaves a scalar tail.
+    std::vector<H3Index> cells;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    for (int bc : {0, 4, 14, 38, 117, 121}) {
+        for (int res = 1; res <= 4; ++res) {
+            std::vector<H3Index> children = h3_toolkit::children_on_boundary_faces(base_cells[bc], res, FaceMask::All);
+            cells.insert(cells.end(), children.begin(), children.end());
+            H3Index center;
+            cellToCenterChild(base_cells[bc], res, &center);
+            cells.push_back(center);
+        }
+    }
+    cells.push_back(0);
+    cells.push_back(~H3Index(0));
+    cells.push_back(base_cells[5]);
+    size_t n = cells.size() | 1;
+    cells.resize(n, base_cells[4]);
+
+    std::vector<FaceMask> masks(n);
+    std::vector<int> res_parents(n);
+    for (size_t i = 0; i < n; ++i) {
+        masks[i] = static_cast<FaceMask>((i * 37) & 0x3F);
+        res_parents[i] = static_cast<int>(i % 5) - 1;
+    }
+
+    SimdLevel original = h3_toolkit::active_simd_level();
+    h3_toolkit::set_simd_level(SimdLevel::Scalar);
+    std::vector<FaceMask> expected(n), expected_each(n), got(n);
+    std::vector<H3Error> expected_status(n), expected_each_status(n), status(n);
+    h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), n, FaceMask::All, 0, expected.data(), expected_status.data());
+    h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), n, masks.data(), res_parents.data(),
+                                              expected_each.data(), expected_each_status.data());
+
+    for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (h3_toolkit::set_simd_level(level) != level) {
+            continue;
+        }
+        h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), n, FaceMask::All, 0, got.data(), status.data());
+        assert(got == expected && status == expected_status);
+        h3_toolkit::trace_cells_to_ancestor_faces(cells.data(), n, masks.data(), res_parents.data(),
+                                                  got.data(), status.data());
+        assert(got == expected_each && status == expected_each_status);
+    }
+    h3_toolkit::set_simd_level(original);
+    std::cout << "SIMD batch trace matches scalar on " << n << " cells (detected level "
+              << static_cast<int>(h3_toolkit::detected_simd_level()) << ")" << std::endl;
+}
+
+void test_coarsest_ancestor_batch() {
+    using h3_toolkit::FaceMask;
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 5, &parent);
+
+    std::vector<H3Index> cells = h3_toolkit::children_on_boundary_faces(parent, 9, h3_toolkit::face_bit(4));
+    H3Index center;
+    cellToCenterChild(parent, 9, &center);
+    cells.push_back(center);
+    cells.push_back(0);
+
+    std::vector<H3Index> ancestors(cells.size());
+    std::vector<int> res(cells.size());
+    std::vector<H3Error> status(cells.size());
+    h3_toolkit::cells_to_coarsest_ancestors_on_faces(cells.data(), cells.size(), FaceMask::All,
+                                                     ancestors.data(), res.data(), status.data());
+    for (size_t i = 0; i + 1 < cells.size(); ++i) {
+        H3Index expected = h3_toolkit::cell_to_coarsest_ancestor_on_faces(cells[i], FaceMask::All);
+        assert(status[i] == E_SUCCESS);
+        assert(ancestors[i] == expected);
+        assert(res[i] == getResolution(expected));
+        // Boundary children of the res 5 parent stay on its boundary up to res 5
+        if (i + 2 < cells.size()) {
+            assert(res[i] <= 5);
+        }
+    }
+    assert(ancestors[cells.size() - 2] == center);
+    assert(status.back() == E_CELL_INVALID && ancestors.back() == H3_NULL && res.back() == -1);
+    std::cout << "Coarsest ancestor batch agrees on " << cells.size() - 1 << " cells" << std::endl;
+}
+
+void test_boundary_children_pentagon() {
+    using h3_toolkit::FaceMask;
+    H3Index pentagons[12];
+    getPentagons(2, pentagons);
+    for (H3Index pent : pentagons) {
+        std::vector<H3Index> children = h3_toolkit::children_on_boundary_faces(pent, 4, FaceMask::All);
+        assert(!children.empty());
+        for (H3Index child : children) {
+            assert(isValidCell(child));
+            assert(getResolution(child) == 4);
+            H3Index parent;
+            cellToParent(child, 2, &parent);
+            assert(parent == pent);
+        }
+    }
+
+    bool threw = false;
+    try {
+        h3_toolkit::children_on_boundary_faces(pentagons[0], 16, FaceMask::All);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "Pentagon boundary children are valid descendants" << std::endl;
+}
+
+void test_boundary_children_streaming() {
+    using h3_toolkit::FaceMask;
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 4, &parent);
+    FaceMask input = h3_toolkit::face_bit(1) | h3_toolkit::face_bit(2) | h3_toolkit::face_bit(6);
+    std::vector<H3Index> expected = h3_toolkit::children_on_boundary_faces(parent, 9, input);
+
+    // Template visitor with per-child faces: the child's own faces that map
+    // onto the requested parent faces
+    std::vector<H3Index> visited;
+    h3_toolkit::for_each_child_on_boundary_faces(parent, 9, input, [&](H3Index child, FaceMask faces) {
+        assert(faces != FaceMask::None);
+        assert(h3_toolkit::trace_cell_to_ancestor_faces(child, faces, 4) ==
+               (h3_toolkit::trace_cell_to_ancestor_faces(child, FaceMask::All, 4) & input));
+        visited.push_back(child);
+    });
+    assert(visited == expected);
+
+    // Range form, spanning several internal buffer refills
+    std::vector<H3Index> ranged;
+    for (h3_toolkit::BoundaryChild c : h3_toolkit::boundary_children(parent, 9, input)) {
+        ranged.push_back(c.cell);
+    }
+    assert(ranged == expected);
+
+    // Type-erased callback, stopping early. A const lvalue, so overload
+    // resolution picks the non-template overload over the template
+    size_t seen = 0;
+    const std::function<bool(H3Index, FaceMask)> callback = [&](H3Index child, FaceMask) {
+        assert(child == expected[seen]);
+        return ++seen < 10;
+    };
+    h3_toolkit::for_each_child_on_boundary_faces(parent, 9, input, callback);
+    assert(seen == 10);
+    std::cout << "Streaming boundary children match vector form (" << expected.size() << " cells)" << std::endl;
+}
+
+void test_count_boundary_children() {
+    using h3_toolkit::FaceMask;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    H3Index pentagons[12];
+    getPentagons(1, pentagons);
+    std::vector<H3Index> parents = {base_cells[0], base_cells[4], base_cells[100], pentagons[3]};
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index sf;
+    latLngToCell(&g, 3, &sf);
+    parents.push_back(sf);
+
+    for (H3Index parent : parents) {
+        int res = getResolution(parent);
+        for (int target = res + 1; target <= res + 5; ++target) {
+            for (int mask = 0; mask < 64; mask += 7) {
+                FaceMask faces = static_cast<FaceMask>(mask);
+                int64_t expected = h3_toolkit::children_on_boundary_faces(parent, target, faces).size();
+                assert(h3_toolkit::count_children_on_boundary_faces(parent, target, faces) == expected);
+            }
+        }
+    }
+    // 43,046,718 is the res 0 -> 15 figure reported by bench_pure_cpp
+    assert(h3_toolkit::count_children_on_boundary_faces(base_cells[0], 15) == 43046718);
+    std::cout << "Boundary child counts match enumeration" << std::endl;
+}
+
+void test_parallel_boundary_children() {
+    using h3_toolkit::FaceMask;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    for (H3Index parent : {base_cells[0], base_cells[14]}) {
+        std::vector<H3Index> serial = h3_toolkit::children_on_boundary_faces(parent, 7, FaceMask::All);
+        for (int threads : {1, 2, 4}) {
+            for (int split : {0, 1, 3, 6, 9}) {
+                h3_toolkit::ParallelOptions options;
+                options.num_threads = threads;
+                options.split_depth = split;
+                assert(h3_toolkit::children_on_boundary_faces_parallel(parent, 7, FaceMask::All, options) == serial);
+            }
+        }
+        assert(h3_toolkit::children_on_boundary_faces_parallel(parent, 1, h3_toolkit::face_bit(2)) ==
+               h3_toolkit::children_on_boundary_faces(parent, 1, h3_toolkit::face_bit(2)));
+    }
+
+    // The shared pool is capped at the hardware concurrency, so on a one or
+    // two core machine the loop above never leaves the calling thread. A
+    // pool with four workers runs the same split (subtrees at res 3, each
+    // enumerated as its own task) whatever the machine.
+    H3Index parent = base_cells[14];
+    std::vector<H3Index> serial = h3_toolkit::children_on_boundary_faces(parent, 7, FaceMask::All);
+    std::vector<std::pair<H3Index, FaceMask>> roots;
+    h3_toolkit::for_each_child_on_boundary_faces(parent, 3, FaceMask::All, [&](H3Index root, FaceMask faces) {
+        roots.emplace_back(root, faces);
+    });
+    std::vector<std::vector<H3Index>> pieces(roots.size());
+    // The first task to start holds its thread until a task runs alongside
+    // it, which only another participant can do
+    std::atomic<bool> claimed{false}, holding{false}, ran_alongside{false};
+    h3_toolkit::detail::ThreadPool pool(4);
+    pool.parallel_for(roots.size(), [&](size_t i) {
+        pieces[i] = h3_toolkit::children_on_boundary_faces(roots[i].first, 7, roots[i].second);
+        if (!claimed.exchange(true)) {
+            holding = true;
+            for (int wait = 0; wait < 10000 && !ran_alongside; ++wait) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            holding = false;
+        } else if (holding) {
+            ran_alongside = true;
+        }
+    });
+    assert(ran_alongside);
+    std::vector<H3Index> stitched;
+    for (const auto& piece : pieces) {
+        stitched.insert(stitched.end(), piece.begin(), piece.end());
+    }
+    assert(stitched == serial);
+    std::cout << "Parallel boundary children match serial order" << std::endl;
+}
+
+void test_boundary_child_rank_select() {
+    using h3_toolkit::FaceMask;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    FaceMask faces = h3_toolkit::face_bit(2) | h3_toolkit::face_bit(3) | h3_toolkit::face_bit(5);
+    for (H3Index parent : {base_cells[7], base_cells[24]}) {
+        std::vector<H3Index> all = h3_toolkit::children_on_boundary_faces(parent, 5, faces);
+        for (size_t k = 0; k < all.size(); ++k) {
+            assert(h3_toolkit::boundary_child_at(parent, 5, faces, (int64_t)k) == all[k]);
+            assert(h3_toolkit::boundary_child_rank(parent, all[k], faces) == (int64_t)k);
+        }
+
+        int64_t n = (int64_t)all.size();
+        std::vector<H3Index> shard = h3_toolkit::boundary_children_in_range(parent, 5, faces, n / 3, 2 * n / 3);
+        assert(shard == std::vector<H3Index>(all.begin() + n / 3, all.begin() + 2 * n / 3));
+        assert(h3_toolkit::boundary_children_in_range(parent, 5, faces, n, n).empty());
+
+        bool threw = false;
+        try {
+            h3_toolkit::boundary_child_at(parent, 5, faces, n);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        // The center child is never on the boundary
+        H3Index center;
+        cellToCenterChild(parent, 5, &center);
+        threw = false;
+        try {
+            h3_toolkit::boundary_child_rank(parent, center, faces);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "Boundary child rank/select round-trips" << std::endl;
+}
+
+void test_boundary_children_templates() {
+    using h3_toolkit::FaceMask;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    // Hexagon parents at both parities share templates; the pentagon-rooted
+    // base cell and its center children exercise the tree-walk fallback.
+    std::vector<H3Index> parents = {base_cells[0], base_cells[14], base_cells[121]};
+    for (H3Index base : {base_cells[3], base_cells[14]}) {
+        for (int res = 1; res <= 2; ++res) {
+            int64_t size;
+            cellToChildrenSize(base, res, &size);
+            std::vector<H3Index> children(size);
+            cellToChildren(base, res, children.data());
+            for (H3Index child : children) {
+                if (child != H3_NULL) parents.push_back(child);
+            }
+        }
+    }
+    for (H3Index parent : parents) {
+        int res = getResolution(parent);
+        for (int target = res + 1; target <= res + 4; ++target) {
+            for (int mask : {63, 1, 18, 44}) {
+                FaceMask faces = static_cast<FaceMask>(mask);
+                std::vector<H3Index> walked;
+                h3_toolkit::for_each_child_on_boundary_faces(parent, target, faces, [&](H3Index child) {
+                    walked.push_back(child);
+                });
+                // Twice: the first call may build the template, the second stamps it
+                assert(h3_toolkit::children_on_boundary_faces(parent, target, faces) == walked);
+                assert(h3_toolkit::children_on_boundary_faces(parent, target, faces) == walked);
+            }
+        }
+    }
+
+    // First calls racing on the same new keys all get the walk's children
+    H3Index parent = parents.back();
+    int res = getResolution(parent);
+    std::vector<std::vector<H3Index>> expected;
+    for (int mask : {7, 21, 42, 56}) {
+        std::vector<H3Index> walked;
+        h3_toolkit::for_each_child_on_boundary_faces(parent, res + 5, static_cast<FaceMask>(mask),
+                                                     [&](H3Index child) { walked.push_back(child); });
+        expected.push_back(walked);
+    }
+    std::vector<std::thread> racers;
+    for (int t = 0; t < 4; ++t) {
+        racers.emplace_back([&] {
+            for (int round = 0; round < 2; ++round) {
+                int k = 0;
+                for (int mask : {7, 21, 42, 56}) {
+                    assert(h3_toolkit::children_on_boundary_faces(parent, res + 5, static_cast<FaceMask>(mask)) ==
+                           expected[k++]);
+                }
+            }
+        });
+    }
+    for (auto& racer : racers) {
+        racer.join();
+    }
+    std::cout << "Template-stamped boundary children match the tree walk" << std::endl;
+}
+
+void test_boundary_children_perimeter() {
+    using h3_toolkit::FaceMask;
+    H3Index base_cells[122];
+    getRes0Cells(base_cells);
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index sf;
+    latLngToCell(&g, 3, &sf);
+
+    FaceMask two_arcs = h3_toolkit::face_bit(4) | h3_toolkit::face_bit(2) | h3_toolkit::face_bit(3);
+    for (H3Index parent : {base_cells[0], sf}) {
+        int res = getResolution(parent);
+        for (int target = res + 1; target <= res + 5; ++target) {
+            for (FaceMask faces : {FaceMask::All, two_arcs, h3_toolkit::face_bit(1)}) {
+                h3_toolkit::PerimeterChildren walk = h3_toolkit::children_on_boundary_faces_perimeter(parent, target, faces);
+                std::vector<H3Index> sorted = walk.cells;
+                std::vector<H3Index> expected = h3_toolkit::children_on_boundary_faces(parent, target, faces);
+                std::sort(sorted.begin(), sorted.end());
+                std::sort(expected.begin(), expected.end());
+                assert(sorted == expected);
+                assert(walk.closed == (faces == FaceMask::All));
+
+                int64_t n = (int64_t)walk.cells.size();
+                for (const h3_toolkit::PerimeterFaceRun& run : walk.face_runs) {
+                    // Exactly the cells in the run touch that face, and
+                    // consecutive cells within it are neighbors
+                    for (int64_t i = 0; i < n; ++i) {
+                        FaceMask traced = h3_toolkit::trace_cell_to_ancestor_faces(walk.cells[i], FaceMask::All, res);
+                        bool in_run = (i >= run.begin && i < run.end) || (walk.closed && i == 0 && run.face == 5);
+                        assert(h3_toolkit::has_face(traced, run.face) == in_run);
+                    }
+                    for (int64_t i = run.begin; i + 1 < run.end; ++i) {
+                        int neighbors;
+                        areNeighborCells(walk.cells[i], walk.cells[i + 1], &neighbors);
+                        assert(neighbors);
+                    }
+                }
+                if (walk.closed) {
+                    std::vector<int> order;
+                    for (const auto& run : walk.face_runs) order.push_back(run.face);
+                    assert(order == std::vector<int>({4, 6, 2, 3, 1, 5}));
+                    assert(walk.face_runs.front().begin == 0 && walk.face_runs.back().end == n);
+                    int neighbors;
+                    areNeighborCells(walk.cells.back(), walk.cells.front(), &neighbors);
+                    assert(neighbors);
+                } else if (faces == two_arcs) {
+                    // Arcs 4 and 2-3, in cyclic order from face 4 (its predecessor 5 is missing)
+                    assert(walk.face_runs.size() == 3 && walk.face_runs[0].face == 4 &&
+                           walk.face_runs[1].face == 2 && walk.face_runs[2].face == 3);
+                }
+            }
+        }
+    }
+
+    // Pentagons skip the missing sector but return the same children
+    std::vector<H3Index> walked = h3_toolkit::children_on_boundary_faces_perimeter(base_cells[14], 4).cells;
+    std::vector<H3Index> expected = h3_toolkit::children_on_boundary_faces(base_cells[14], 4);
+    std::sort(walked.begin(), walked.end());
+    std::sort(expected.begin(), expected.end());
+    assert(walked == expected);
+    std::cout << "Perimeter-ordered boundary children walk the edge" << std::endl;
+}
+
+void test_cell_boundary_from_children() {
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index parent;
+    latLngToCell(&g, 6, &parent);
+
+    for (int target = 7; target <= 10; ++target) {
+        std::vector<std::pair<double, double>> ring = h3_toolkit::cell_boundary_from_children(parent, target).outer();
+        assert(ring.size() > 3 && ring.front() == ring.back());
+        size_t n = ring.size() - 1;
+
+        // Every exterior edge of every boundary child runs along the ring.
+        // Edges can have more than two vertices (class III edges crossing an
+        // icosahedron edge have three), so match them vertex by vertex; the
+        // ring is clockwise, so each edge appears reversed.
+        h3_toolkit::PerimeterChildren walk = h3_toolkit::children_on_boundary_faces_perimeter(parent, target);
+        size_t edge_points = 0;
+        for (H3Index child : walk.cells) {
+            H3Index edges[6];
+            originToDirectedEdges(child, edges);
+            for (H3Index edge : edges) {
+                H3Index neighbor, neighbor_parent;
+                if (edge == H3_NULL || getDirectedEdgeDestination(edge, &neighbor) != E_SUCCESS) {
+                    continue;
+                }
+                cellToParent(neighbor, 6, &neighbor_parent);
+                if (neighbor_parent == parent) {
+                    continue;
+                }
+                CellBoundary cb;
+                directedEdgeToBoundary(edge, &cb);
+                auto vertex = [&](int v) {
+                    return std::make_pair(radsToDegs(cb.verts[v].lng), radsToDegs(cb.verts[v].lat));
+                };
+                size_t start = std::find(ring.begin(), ring.end() - 1, vertex(cb.numVerts - 1)) - ring.begin();
+                assert(start < n);
+                for (int m = 1; m < cb.numVerts; ++m) {
+                    assert(ring[(start + m) % n] == vertex(cb.numVerts - 1 - m));
+                }
+                edge_points += cb.numVerts - 1;
+            }
+        }
+        // ... and nothing else is on it
+        assert(edge_points == n);
+
+        // Clockwise (negative shoelace area), and close to the parent's own area
+        double twice_area = 0;
+        for (size_t i = 0; i + 1 < ring.size(); ++i) {
+            twice_area += ring[i].first * ring[i + 1].second - ring[i + 1].first * ring[i].second;
+        }
+        std::vector<std::pair<double, double>> hexagon = h3_toolkit::cell_boundary(parent).outer();
+        double twice_hexagon = 0;
+        for (size_t i = 0; i + 1 < hexagon.size(); ++i) {
+            twice_hexagon += hexagon[i].first * hexagon[i + 1].second - hexagon[i + 1].first * hexagon[i].second;
+        }
+        assert(twice_area < 0);
+        assert(std::abs(std::abs(twice_area) / std::abs(twice_hexagon) - 1.0) < 0.05);
+    }
+
+    // Pentagons go through the cascaded union instead
+    H3Index pentagons[12];
+    getPentagons(4, pentagons);
+    std::vector<std::pair<double, double>> ring = h3_toolkit::cell_boundary_from_children(pentagons[0], 7).outer();
+    std::vector<std::pair<double, double>> coarse = h3_toolkit::cell_boundary_from_children(pentagons[0], 5).outer();
+    assert(ring.size() > coarse.size() && coarse.size() > 6);
+    assert(ring.front() == ring.back());
+    std::cout << "Outline traced from exterior edges" << std::endl;
+}
+
+double ring_area(const std::vector<std::pair<double, double>>& ring) {
+    double twice_area = 0;
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+        twice_area += ring[i].first * ring[i + 1].second - ring[i + 1].first * ring[i].second;
+    }
+    return twice_area / 2;
+}
+
+void test_cell_polygons_from_children() {
+    using h3_toolkit::OutlineBackend;
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index hexagon;
+    latLngToCell(&g, 6, &hexagon);
+    H3Index pentagons[12];
+    getPentagons(5, pentagons);
+
+    for (H3Index parent : {hexagon, pentagons[2]}) {
+        int res = getResolution(parent);
+        for (int target = res + 1; target <= res + 3; ++target) {
+            auto native = h3_toolkit::cell_polygons_from_children(parent, target, OutlineBackend::H3);
+            auto boost = h3_toolkit::cell_polygons_from_children(parent, target, OutlineBackend::Boost);
+            // The band of boundary children: one polygon, holed by the interior
+            assert(native.num_parts() == 1 && boost.num_parts() == 1);
+            assert(native.num_rings() == boost.num_rings());
+            if (parent == hexagon) {
+                assert(native.num_rings() == 2);
+                assert(ring_area(native.ring(1)) > 0);  // holes run counter-clockwise
+            }
+            for (size_t ring = 0; ring < native.num_rings(); ++ring) {
+                assert(native.ring(ring).size() == boost.ring(ring).size());
+                assert(native.ring(ring).front() == native.ring(ring).back());
+                double a = ring_area(native.ring(ring));
+                double b = ring_area(boost.ring(ring));
+                assert(std::abs(a - b) <= 1e-9 * std::abs(b));
+            }
+            // Outer ring clockwise, as in cell_boundary_from_children, which drops the hole
+            assert(ring_area(native.outer()) < 0);
+            h3_toolkit::PolygonResult outline = h3_toolkit::cell_boundary_from_children(parent, target);
+            assert(outline.num_parts() == 1 && outline.num_rings() == 1);
+            assert(std::abs(ring_area(outline.outer()) - ring_area(native.outer())) <=
+                   1e-9 * std::abs(ring_area(native.outer())));
+        }
+    }
+    std::cout << "Native and Boost outline backends agree" << std::endl;
+}
+
+void test_polygon_result() {
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index cell;
+    latLngToCell(&g, 6, &cell);
+
+    // Offsets are consistent across parts and rings
+    h3_toolkit::PolygonResult band = h3_toolkit::cell_polygons_from_children(cell, 8);
+    assert(band.part_offsets.front() == 0 && band.part_offsets.back() == band.num_rings());
+    assert(band.ring_offsets.front() == 0 && band.ring_offsets.back() == band.num_points());
+    assert(band.num_parts() == 1 && band.num_rings() == 2 && !band.empty());
+    assert(band.outer() == band.ring(0) && band.ring(0).size() + band.ring(1).size() == band.num_points());
+
+    // Built part by part: a polygon with a hole, then a second part
+    h3_toolkit::PolygonResult built;
+    assert(built.empty() && built.num_parts() == 0 && built.outer().empty());
+    for (size_t j = 0; j < band.num_rings(); ++j) {
+        for (const auto& p : band.ring(j)) {
+            built.add_point(p.first, p.second);
+        }
+        built.end_ring();
+    }
+    built.end_part();
+    assert(built == band);
+    for (const auto& p : h3_toolkit::cell_boundary(cell).outer()) {
+        built.add_point(p.first, p.second);
+    }
+    built.end_ring();
+    built.end_part();
+    assert(built.num_parts() == 2 && built.num_rings() == 3 && built.part_offsets == std::vector<uint32_t>({0, 2, 3}));
+    assert(built.ring(2) == h3_toolkit::cell_boundary(cell).outer() && built != band);
+
+    // Moving hands over the buffers
+    const double* data = built.coords.data();
+    h3_toolkit::PolygonResult moved = std::move(built);
+    assert(moved.coords.data() == data && moved.num_parts() == 2);
+    std::cout << "Polygon results with parts and holes" << std::endl;
+}
+
+void test_convex_hull_mode() {
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index cell;
+    latLngToCell(&g, 6, &cell);
+
+    for (int target = 8; target <= 10; ++target) {
+        // No buffer: the hull itself, clockwise and closed
+        auto hull = h3_toolkit::get_buffered_boundary_polygon(cell, target, 0.0, true).outer();
+        assert(hull.size() >= 4 && hull.front() == hull.back());
+        assert(ring_area(hull) < 0);
+
+        std::set<std::pair<double, double>> vertices;
+        for (H3Index child : h3_toolkit::children_on_boundary_faces(cell, target, h3_toolkit::FaceMask::All)) {
+            auto boundary = h3_toolkit::cell_boundary(child).outer();
+            vertices.insert(boundary.begin(), boundary.end());
+        }
+        for (size_t i = 0; i + 1 < hull.size(); ++i) {
+            const auto& a = hull[i];
+            const auto& b = hull[i + 1];
+            const auto& c = hull[(i + 2) % (hull.size() - 1)];
+            // Strictly convex, with corners taken from the children's vertices
+            assert((b.first - a.first) * (c.second - a.second) - (b.second - a.second) * (c.first - a.first) < 0);
+            assert(std::any_of(vertices.begin(), vertices.end(), [&](const std::pair<double, double>& v) {
+                return std::abs(v.first - a.first) < 1e-9 && std::abs(v.second - a.second) < 1e-9;
+            }));
+            // Every child vertex lies inside or on the hull
+            for (const auto& v : vertices) {
+                double side = (b.first - a.first) * (v.second - a.second) - (b.second - a.second) * (v.first - a.first);
+                assert(side <= 1e-12);
+            }
+        }
+    }
+    std::cout << "Convex hull from exterior vertices" << std::endl;
+}
+
+void test_buffer_projection() {
+    using h3_toolkit::BufferProjection;
+    LatLng g;
+    g.lat = degsToRads(20.5);
+    g.lng = degsToRads(10.0);
+    H3Index cell;
+    latLngToCell(&g, 7, &cell);
+    LatLng center;
+    cellToLatLng(cell, &center);
+
+    // Distances from the center bracket the cell: vertices and edge midpoints
+    auto boundary = h3_toolkit::cell_boundary(cell).outer();
+    double circumradius = 0, inradius = 1e300;
+    for (size_t i = 0; i + 1 < boundary.size(); ++i) {
+        LatLng v = {degsToRads(boundary[i].second), degsToRads(boundary[i].first)};
+        LatLng mid = {degsToRads((boundary[i].second + boundary[i + 1].second) / 2),
+                      degsToRads((boundary[i].first + boundary[i + 1].first) / 2)};
+        circumradius = std::max(circumradius, greatCircleDistanceM(&center, &v));
+        inradius = std::min(inradius, greatCircleDistanceM(&center, &mid));
+    }
+
+    // In the local projection the buffer is the same distance in every direction
+    const double buffer = 200.0;
+    auto local = h3_toolkit::get_buffered_h3_polygon(cell, buffer, BufferProjection::LocalAzimuthalEquidistant).outer();
+    assert(local.size() > boundary.size() && local.front() == local.back());
+    assert(ring_area(local) < 0);
+    for (const auto& p : local) {
+        LatLng v = {degsToRads(p.second), degsToRads(p.first)};
+        double d = greatCircleDistanceM(&center, &v);
+        assert(d >= inradius + 0.99 * buffer && d <= circumradius + 1.01 * buffer);
+    }
+
+    // The default is unchanged, and the projection is part of the cache key
+    h3_toolkit::set_polygon_cache_capacity(1 << 20);
+    auto degrees = h3_toolkit::get_buffered_h3_polygon(cell, buffer);
+    assert(degrees == h3_toolkit::get_buffered_h3_polygon(cell, buffer, BufferProjection::Degrees));
+    assert(degrees != h3_toolkit::get_buffered_h3_polygon(cell, buffer, BufferProjection::LocalAzimuthalEquidistant));
+    h3_toolkit::set_polygon_cache_capacity(0);
+    h3_toolkit::clear_polygon_cache();
+
+    auto boundary_local = h3_toolkit::get_buffered_boundary_polygon(cell, 10, -1.0, false,
+                                                                    BufferProjection::LocalAzimuthalEquidistant);
+    assert(std::abs(ring_area(boundary_local.outer())) >
+           std::abs(ring_area(h3_toolkit::cell_boundary_from_children(cell, 10).outer())));
+    std::cout << "Buffering in a local azimuthal equidistant projection" << std::endl;
+}
+
+void test_descendant_overhang() {
+    using h3_toolkit::max_descendant_overhang;
+    for (int res = 0; res <= 15; ++res) {
+        assert(max_descendant_overhang(res, res) == 0 && max_descendant_overhang(res, res, true) == 0);
+        for (int d = res + 1; d <= 15; ++d) {
+            double hexagon = max_descendant_overhang(res, d);
+            // Deeper descendants reach further, finer ancestors less far; pentagons are smaller
+            assert(hexagon >= max_descendant_overhang(res, d - 1) && hexagon > 0);
+            assert(res == 0 || hexagon < max_descendant_overhang(res - 1, d));
+            assert(max_descendant_overhang(res, d, true) < hexagon);
+        }
+    }
+    for (auto args : {std::make_pair(10, 9), std::make_pair(-1, 5), std::make_pair(5, 16)}) {
+        bool threw = false;
+        try {
+            max_descendant_overhang(args.first, args.second);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    LatLng g;
+    g.lat = degsToRads(20.5);
+    g.lng = degsToRads(10.0);
+    H3Index cell;
+    latLngToCell(&g, 9, &cell);
+
+    // Auto mode buffers by the table
+    using h3_toolkit::BufferProjection;
+    auto buffered = h3_toolkit::get_buffered_h3_polygon(cell, -1.0, BufferProjection::LocalAzimuthalEquidistant);
+    assert(buffered == h3_toolkit::get_buffered_h3_polygon(cell, max_descendant_overhang(9, 15),
+                                                           BufferProjection::LocalAzimuthalEquidistant));
+    assert(h3_toolkit::get_buffered_boundary_polygon(cell, 11, -1.0, true,
+                                                     BufferProjection::LocalAzimuthalEquidistant) ==
+           h3_toolkit::get_buffered_boundary_polygon(cell, 11, max_descendant_overhang(11, 15), true,
+                                                     BufferProjection::LocalAzimuthalEquidistant));
+    // In degrees it divides by the longitude scale alone, so reaches further
+    auto max_lon = [](const h3_toolkit::PolygonResult& polygon) {
+        double lon = -180.0;
+        for (const auto& v : polygon.outer()) {
+            lon = std::max(lon, v.first);
+        }
+        return lon;
+    };
+    assert(max_lon(h3_toolkit::get_buffered_boundary_polygon(cell, 11)) >
+           max_lon(h3_toolkit::get_buffered_boundary_polygon(cell, 11, max_descendant_overhang(11, 15))));
+
+    // ... which covers the descendants
+    std::vector<std::pair<double, double>> ring = buffered.outer();
+    auto inside = [&](const std::pair<double, double>& p) {
+        bool in = false;
+        for (size_t i = 0; i + 1 < ring.size(); ++i) {
+            const auto& a = ring[i];
+            const auto& b = ring[i + 1];
+            if ((a.second > p.second) != (b.second > p.second) &&
+                p.first < a.first + (p.second - a.second) * (b.first - a.first) / (b.second - a.second)) {
+                in = !in;
+            }
+        }
+        return in;
+    };
+    int64_t num_children;
+    cellToChildrenSize(cell, 13, &num_children);
+    std::vector<H3Index> children(num_children);
+    cellToChildren(cell, 13, children.data());
+    for (H3Index child : children) {
+        for (const auto& v : h3_toolkit::cell_boundary(child).outer()) {
+            assert(inside(v));
+        }
+    }
+
+    // Also in degrees far from the equator, where a degree of longitude is
+    // short: every res 15 descendant vertex stays inside
+    LatLng north;
+    north.lat = degsToRads(60.0);
+    north.lng = degsToRads(10.0);
+    H3Index northern;
+    latLngToCell(&north, 11, &northern);
+    cellToChildrenSize(northern, 15, &num_children);
+    std::vector<H3Index> descendants(num_children);
+    cellToChildren(northern, 15, descendants.data());
+    for (const auto& polygon : {h3_toolkit::get_buffered_h3_polygon(northern),
+                                h3_toolkit::get_buffered_boundary_polygon(northern, 12, -1.0, false)}) {
+        assert(polygon.num_parts() == 1);
+        ring = polygon.outer();
+        for (H3Index descendant : descendants) {
+            for (const auto& v : h3_toolkit::cell_boundary(descendant).outer()) {
+                assert(inside(v));
+            }
+        }
+    }
+
+    // Res 15 cells have no descendants to cover
+    H3Index finest;
+    latLngToCell(&g, 15, &finest);
+    assert(h3_toolkit::get_buffered_h3_polygon(finest).num_points() == 7);
+    std::cout << "Auto buffers from the descendant overhang table" << std::endl;
+}
+
+void test_convex_offset() {
+    LatLng g;
+    g.lat = degsToRads(20.5);
+    g.lng = degsToRads(10.0);
+    for (int res : {3, 9, 15}) {
+        H3Index cell;
+        latLngToCell(&g, res, &cell);
+        auto hexagon = h3_toolkit::cell_boundary(cell).outer();
+        double avg_lat = 0;
+        for (size_t i = 0; i + 1 < hexagon.size(); ++i) {
+            avg_lat += hexagon[i].second / (hexagon.size() - 1);
+        }
+        double edge_m;
+        getHexagonEdgeLengthAvgM(res, &edge_m);
+        double buffer_degrees = edge_m / (111320.0 * (1 + std::cos(degsToRads(avg_lat))) / 2);
+
+        // Convex input takes the analytic offset: every vertex is exactly the
+        // buffer away from the hexagon, on an edge's parallel or a corner's arc
+        auto buffered = h3_toolkit::get_buffered_h3_polygon(cell, edge_m).outer();
+        assert(buffered.front() == buffered.back() && ring_area(buffered) < 0);
+        assert(buffered.size() > 2 * (hexagon.size() - 1));
+        for (const auto& p : buffered) {
+            double nearest = 1e300;
+            for (size_t i = 0; i + 1 < hexagon.size(); ++i) {
+                double ax = hexagon[i].first, ay = hexagon[i].second;
+                double ex = hexagon[i + 1].first - ax, ey = hexagon[i + 1].second - ay;
+                double t = std::max(0.0, std::min(1.0, ((p.first - ax) * ex + (p.second - ay) * ey) / (ex * ex + ey * ey)));
+                nearest = std::min(nearest, std::hypot(p.first - ax - t * ex, p.second - ay - t * ey));
+            }
+            assert(std::abs(nearest - buffer_degrees) < 1e-9 * buffer_degrees + 1e-12);
+        }
+    }
+    std::cout << "Analytic offset of convex rings" << std::endl;
+}
+
+void test_containment_polygon() {
+    LatLng g;
+    g.lat = degsToRads(20.5);
+    g.lng = degsToRads(10.0);
+    H3Index cell;
+    latLngToCell(&g, 6, &cell);
+
+    h3_toolkit::ContainmentBudget budget;
+    budget.max_vertices = 12;
+    h3_toolkit::ContainmentPolygon result = h3_toolkit::get_containment_polygon(cell, budget);
+    assert(result.polygon.num_parts() == 1 && result.polygon.num_rings() == 1);
+    const auto ring = result.polygon.outer();
+    assert(result.vertex_count <= 12 && result.vertex_count + 1 == ring.size() && ring.front() == ring.back());
+    assert(result.intermediate_res > 6 && result.intermediate_res <= 10 && result.buffer_meters > 0);
+    assert(result.within_budget == (result.inflation <= budget.max_inflation));
+    assert(ring_area(ring) < 0);
+    double ratio = std::abs(ring_area(ring) / ring_area(h3_toolkit::cell_boundary(cell).outer()));
+    assert(result.inflation > 1 && std::abs(result.inflation - ratio) < 0.01 * ratio);
+
+    // Convex and clockwise: every vertex turns right
+    auto cross = [](const std::pair<double, double>& a, const std::pair<double, double>& b,
+                    const std::pair<double, double>& c) {
+        return (b.first - a.first) * (c.second - a.second) - (b.second - a.second) * (c.first - a.first);
+    };
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+        assert(cross(ring[i], ring[i + 1], ring[(i + 2) % (ring.size() - 1)]) < 0);
+    }
+
+    // Every intermediate child is inside, at least the buffer away from each edge
+    const double meters_per_degree = 6371007.180918475 * M_PI / 180;
+    int64_t num_children;
+    cellToChildrenSize(cell, result.intermediate_res, &num_children);
+    std::vector<H3Index> children(num_children);
+    cellToChildren(cell, result.intermediate_res, children.data());
+    for (H3Index child : children) {
+        for (const auto& v : h3_toolkit::cell_boundary(child).outer()) {
+            double kx = meters_per_degree * std::cos(degsToRads(v.second));
+            for (size_t i = 0; i + 1 < ring.size(); ++i) {
+                double ex = (ring[i + 1].first - ring[i].first) * kx;
+                double ey = (ring[i + 1].second - ring[i].second) * meters_per_degree;
+                double side = cross(ring[i], ring[i + 1], v) * kx * meters_per_degree / std::hypot(ex, ey);
+                assert(side <= -0.99 * result.buffer_meters);
+            }
+        }
+    }
+
+    // A tighter budget can only cost area
+    budget.max_vertices = 6;
+    h3_toolkit::ContainmentPolygon tight = h3_toolkit::get_containment_polygon(cell, budget);
+    assert(tight.vertex_count <= 6 && tight.inflation >= result.inflation);
+
+    budget.max_vertices = 2;
+    bool threw = false;
+    try {
+        h3_toolkit::get_containment_polygon(cell, budget);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "Containment polygon within a vertex budget" << std::endl;
+}
+
+void test_polygon_batch() {
+    std::vector<H3Index> cells;
+    for (int i = 0; i < 150; ++i) {
+        LatLng g = {degsToRads(-30.0 + 0.4 * i), degsToRads(-120.0 + 1.5 * i)};
+        H3Index cell;
+        latLngToCell(&g, i % 3 == 0 ? 9 : 6, &cell);
+        cells.push_back(cell);
+    }
+    cells[17] = 0;  // invalid
+
+    // Polygon i of a batch, as the single-cell functions return it
+    auto polygon = [](const h3_toolkit::PolygonBatch& batch, size_t i) { return batch.polygon(i); };
+    auto check_layout = [&](const h3_toolkit::PolygonBatch& batch) {
+        assert(batch.size() == cells.size() && batch.polygon_offsets.size() == cells.size() + 1);
+        assert(batch.polygon_offsets.front() == 0 && batch.polygon_offsets.back() + 1 == batch.part_offsets.size());
+        assert(batch.part_offsets.front() == 0 && batch.part_offsets.back() + 1 == batch.ring_offsets.size());
+        assert(batch.ring_offsets.front() == 0 && 2 * batch.ring_offsets.back() == batch.coords.size());
+        assert(batch.status[17] == E_CELL_INVALID && polygon(batch, 17).empty());
+    };
+
+    for (int threads : {1, 4}) {
+        h3_toolkit::ParallelOptions options;
+        options.num_threads = threads;
+
+        h3_toolkit::PolygonBatch boundaries = h3_toolkit::cell_boundaries(cells.data(), cells.size(), options);
+        check_layout(boundaries);
+        // res 9 cells cannot descend to res 8: their status says so
+        h3_toolkit::PolygonBatch outlines =
+            h3_toolkit::cell_boundaries_from_children(cells.data(), cells.size(), 8, options);
+        check_layout(outlines);
+        h3_toolkit::PolygonBatch single = h3_toolkit::get_buffered_h3_polygons(
+            cells.data(), cells.size(), 50.0, h3_toolkit::BufferProjection::LocalAzimuthalEquidistant, options);
+        check_layout(single);
+        h3_toolkit::PolygonBatch buffered =
+            h3_toolkit::get_buffered_boundary_polygons(cells.data(), cells.size(), 10, -1.0, true,
+                                                       h3_toolkit::BufferProjection::Degrees, options);
+        check_layout(buffered);
+
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (i == 17) {
+                continue;
+            }
+            assert(boundaries.status[i] == E_SUCCESS && polygon(boundaries, i) == h3_toolkit::cell_boundary(cells[i]));
+            if (getResolution(cells[i]) < 8) {
+                assert(outlines.status[i] == E_SUCCESS &&
+                       polygon(outlines, i) == h3_toolkit::cell_boundary_from_children(cells[i], 8));
+            } else {
+                assert(outlines.status[i] == E_RES_DOMAIN && polygon(outlines, i).empty());
+            }
+            assert(polygon(single, i) == h3_toolkit::get_buffered_h3_polygon(
+                                             cells[i], 50.0, h3_toolkit::BufferProjection::LocalAzimuthalEquidistant));
+            assert(polygon(buffered, i) == h3_toolkit::get_buffered_boundary_polygon(cells[i], 10));
+        }
+    }
+
+    // A bad shared buffer throws, like the single-cell functions, instead of
+    // failing every cell with E_RES_DOMAIN
+    H3Index some_cell;
+    LatLng origin = {degsToRads(20.5), degsToRads(10.0)};
+    latLngToCell(&origin, 6, &some_cell);
+    for (int function = 0; function < 2; ++function) {
+        bool threw = false;
+        try {
+            if (function == 0) {
+                h3_toolkit::get_buffered_h3_polygons(&some_cell, 1, std::nan(""));
+            } else {
+                h3_toolkit::get_buffered_boundary_polygons(&some_cell, 1, 10, std::nan(""));
+            }
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    h3_toolkit::PolygonBatch empty = h3_toolkit::cell_boundaries(nullptr, 0);
+    assert(empty.size() == 0 && empty.polygon_offsets.size() == 1 && empty.part_offsets.size() == 1 &&
+           empty.ring_offsets.size() == 1);
+    std::cout << "Batch polygons in CSR form" << std::endl;
+}
+
+void test_polygon_cache() {
+    LatLng g;
+    g.lat = degsToRads(37.775938728915946);
+    g.lng = degsToRads(-122.41795063018799);
+    H3Index cell;
+    latLngToCell(&g, 6, &cell);
+
+    // Disabled by default: nothing is counted or stored
+    h3_toolkit::clear_polygon_cache();
+    auto boundary = h3_toolkit::cell_boundary_from_children(cell, 9);
+    auto buffered = h3_toolkit::get_buffered_boundary_polygon(cell, 9, -1.0, false);
+    auto single = h3_toolkit::get_buffered_h3_polygon(cell);
+    h3_toolkit::PolygonCacheStats stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.hits == 0 && stats.misses == 0 && stats.entries == 0 && stats.capacity_bytes == 0);
+
+    // A miss per call, then hits returning identical polygons
+    h3_toolkit::set_polygon_cache_capacity(64 << 20);
+    for (int round = 0; round < 3; ++round) {
+        assert(h3_toolkit::cell_boundary_from_children(cell, 9) == boundary);
+        assert(h3_toolkit::get_buffered_boundary_polygon(cell, 9, -1.0, false) == buffered);
+        assert(h3_toolkit::get_buffered_h3_polygon(cell) == single);
+    }
+    stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.misses == 3 && stats.hits == 6 && stats.entries == 3);
+    assert(stats.bytes >= (boundary.coords.size() + buffered.coords.size() + single.coords.size()) * sizeof(double));
+
+    // Every argument is part of the key
+    assert(h3_toolkit::get_buffered_boundary_polygon(cell, 9, -1.0, true) != buffered);
+    assert(h3_toolkit::cell_boundary_from_children(cell, 8) != boundary);
+    assert(h3_toolkit::polygon_cache_stats().entries == 5);
+
+    // 0.0 and -0.0 share an entry; non-finite buffers are rejected, not cached
+    auto unbuffered = h3_toolkit::get_buffered_h3_polygon(cell, 0.0);
+    assert(h3_toolkit::get_buffered_h3_polygon(cell, -0.0) == unbuffered);
+    assert(h3_toolkit::polygon_cache_stats().entries == 6);
+    for (double bad : {std::nan(""), HUGE_VAL}) {
+        bool threw = false;
+        try {
+            h3_toolkit::get_buffered_boundary_polygon(cell, 9, bad);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.entries == 6 && stats.hits == 7);
+
+    // Concurrent readers all see the cached result
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                assert(h3_toolkit::cell_boundary_from_children(cell, 9) == boundary);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(h3_toolkit::polygon_cache_stats().hits == 7 + 400);
+
+    // A small budget evicts least recently used entries and stays within bounds
+    h3_toolkit::clear_polygon_cache();
+    h3_toolkit::set_polygon_cache_capacity(64 << 10);
+    std::vector<H3Index> children(7);
+    cellToChildren(cell, 7, children.data());
+    for (int round = 0; round < 2; ++round) {
+        for (H3Index child : children) {
+            for (int target = 9; target <= 11; ++target) {
+                h3_toolkit::cell_boundary_from_children(child, target);
+            }
+        }
+    }
+    stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.evictions > 0 && stats.bytes <= stats.capacity_bytes);
+    assert(stats.hits + stats.misses == 2 * 7 * 3);
+
+    // Shrinking evicts immediately; zero disables and empties the cache
+    h3_toolkit::set_polygon_cache_capacity(0);
+    stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.entries == 0 && stats.bytes == 0);
+    h3_toolkit::cell_boundary_from_children(cell, 9);
+    assert(h3_toolkit::polygon_cache_stats().entries == 0);
+
+    // Inserts racing a disable never leave entries behind in the disabled cache
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&, t] {
+            while (!stop) {
+                for (int target = 8; target <= 10; ++target) {
+                    h3_toolkit::cell_boundary_from_children(children[t], target);
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 200; ++round) {
+        h3_toolkit::set_polygon_cache_capacity(64 << 20);
+        std::this_thread::yield();
+        h3_toolkit::set_polygon_cache_capacity(0);
+    }
+    stop = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    stats = h3_toolkit::polygon_cache_stats();
+    assert(stats.capacity_bytes == 0 && stats.entries == 0 && stats.bytes == 0);
+    h3_toolkit::clear_polygon_cache();
+    std::cout << "Polygon cache hits, misses and evictions" << std::endl;
+}
+
+void test_polygon_store() {
+    namespace fs = std::filesystem;
+    std::string path = (fs::temp_directory_path() / "h3_toolkit_test_store.bin").string();
+    fs::remove(path);
+    fs::remove(path + ".partial");
+
+    h3_toolkit::PolygonStoreSpec spec;
+    spec.function = h3_toolkit::StoredPolygon::BoundaryFromChildren;
+    spec.cell_res = 0;
+    spec.target_res = 2;
+
+    // Interrupt the build after its first checkpoint, then resume it
+    h3_toolkit::PolygonStoreBuildOptions options;
+    options.chunk_size = 50;
+    options.progress = [](size_t done, size_t) {
+        if (done == 50) throw std::runtime_error("interrupted");
+    };
+    bool interrupted = false;
+    try {
+        h3_toolkit::build_polygon_store(path, spec, options);
+    } catch (const std::runtime_error&) {
+        interrupted = true;
+    }
+    assert(interrupted && !fs::exists(path) && fs::exists(path + ".partial"));
+
+    // A different spec may not reuse the checkpoint
+    h3_toolkit::PolygonStoreSpec other = spec;
+    other.target_res = 3;
+    bool rejected = false;
+    try {
+        h3_toolkit::build_polygon_store(path, other, options);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    size_t first_progress = 0;
+    options.progress = [&](size_t done, size_t) {
+        if (first_progress == 0) first_progress = done;
+    };
+    h3_toolkit::build_polygon_store(path, spec, options);
+    assert(first_progress == 100);
+    assert(fs::exists(path) && !fs::exists(path + ".partial"));
+
+    h3_toolkit::PolygonStore store(path);
+    assert(store.size() == 122);
+    assert(store.spec().function == spec.function && store.spec().target_res == 2);
+    H3Index base[122];
+    getRes0Cells(base);
+    for (H3Index cell : base) {
+        h3_toolkit::PolygonView view = store.find(cell);
+        assert(view);
+        auto expected = h3_toolkit::cell_boundary_from_children(cell, 2);
+        assert(view.num_points == expected.num_points());
+        assert(view.num_rings == expected.num_rings() && view.num_parts == expected.num_parts());
+        for (size_t i = 0; i < view.num_points; ++i) {
+            assert(view[i] == expected.point(i));
+        }
+        assert(view.to_result() == expected && store.polygon(cell) == expected);
+    }
+
+    // Misses fall back to live computation
+    H3Index child;
+    cellToCenterChild(base[5], 1, &child);
+    assert(!store.find(child));
+    assert(store.polygon(child) == h3_toolkit::cell_boundary_from_children(child, 2));
+
+    // Corrupt files are rejected when opened: a header count large enough to
+    // overflow the size check, an out-of-range enum, unsorted keys, an offset
+    // that steps back, and a truncated file
+    auto rejects = [&](size_t offset, const void* bytes, size_t size) {
+        std::string copy = path + ".corrupt";
+        fs::copy_file(path, copy, fs::copy_options::overwrite_existing);
+        {
+            std::fstream file(copy, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        }
+        bool corrupt = false;
+        try {
+            h3_toolkit::PolygonStore opened(copy);
+        } catch (const std::runtime_error&) {
+            corrupt = true;
+        }
+        fs::remove(copy);
+        return corrupt;
+    };
+    const size_t keys = 80, polygon_offsets = keys + 122 * 8;
+    const uint64_t huge_count = (UINT64_MAX - 80) / 8 + 1;
+    const uint32_t bad_enum = 7;
+    const uint64_t swapped[2] = {base[1], base[0]};
+    const uint64_t back = 0;
+    assert(rejects(40, &huge_count, sizeof(huge_count)));  // StoreHeader::count
+    assert(rejects(16, &bad_enum, sizeof(bad_enum)));      // StoreHeader::function
+    assert(rejects(56, &bad_enum, sizeof(bad_enum)));      // StoreHeader::projection
+    assert(rejects(keys, swapped, sizeof(swapped)));
+    assert(rejects(polygon_offsets + 2 * 8, &back, sizeof(back)));
+    fs::resize_file(path, fs::file_size(path) - 8);
+    bool corrupt = false;
+    try {
+        h3_toolkit::PolygonStore truncated(path);
+    } catch (const std::runtime_error&) {
+        corrupt = true;
+    }
+    assert(corrupt);
+    fs::remove(path);
+    std::cout << "Polygon store build, resume and lookup" << std::endl;
+}
+
 int main() {
     try {
         test_trace_to_parent();
         test_trace_to_ancestor();
+        test_boundary_children_trace_back();
+        test_face_mask_overloads();
+        test_batch_trace();
+        test_batch_trace_simd_levels();
+        test_coarsest_ancestor_batch();
+        test_boundary_children_pentagon();
+        test_boundary_children_streaming();
+        test_count_boundary_children();
+        test_parallel_boundary_children();
+        test_boundary_child_rank_select();
+        test_boundary_children_templates();
+        test_boundary_children_perimeter();
+        test_cell_boundary_from_children();
+        test_cell_polygons_from_children();
+        test_polygon_result();
+        test_convex_hull_mode();
+        test_buffer_projection();
+        test_descendant_overhang();
+        test_convex_offset();
+        test_containment_polygon();
+        test_polygon_batch();
+        test_polygon_cache();
+        test_polygon_store();
         std::cout << "All C++ tests passed!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
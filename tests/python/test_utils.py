@@ -45,3 +45,44 @@ def test_geojson_conversion():
     assert feature['type'] == 'Feature'
     assert feature['geometry']['type'] == 'Polygon'
     assert feature['properties']['h3_index'] == H3_CELL
+
+
+def _cpp_overhang_table():
+    """kDescendantOverhangM parsed out of the generated C++ header."""
+    import os
+    import re
+    path = os.path.join(os.path.dirname(__file__), "..", "..", "src", "cpp", "src", "overhang_table.hpp")
+    with open(path) as f:
+        body = f.read().split("kDescendantOverhangM", 1)[1]
+    rows = re.findall(r"\{([-0-9.e+, ]+)\}", body)
+    values = [[float(v) for v in row.split(",")] for row in rows]
+    return [values[:16], values[16:32]]
+
+
+def test_max_descendant_overhang_matches_cpp_table():
+    from h3_toolkit.geom import max_descendant_overhang
+    table = _cpp_overhang_table()
+    for pentagon in (False, True):
+        for res in range(16):
+            for descendant_res in range(res, 16):
+                expected = table[1 if pentagon else 0][res][descendant_res]
+                assert max_descendant_overhang(res, descendant_res, pentagon) == pytest.approx(expected)
+
+
+@pytest.mark.parametrize("res, descendant_res", [(10, 9), (-1, 5), (5, 16)])
+def test_max_descendant_overhang_out_of_range(res, descendant_res):
+    from h3_toolkit.geom import max_descendant_overhang
+    with pytest.raises(ValueError):
+        max_descendant_overhang(res, descendant_res)
+
+
+def test_auto_buffer_covers_descendants_at_high_latitude():
+    # At 60N a degree of longitude is half a degree of latitude; the auto
+    # buffer must still reach every res 13 descendant vertex
+    from shapely.geometry import Point, shape
+    from h3_toolkit.geom import get_buffered_h3_polygon, get_buffered_boundary_polygon
+    cell = h3.latlng_to_cell(60.0, 10.0, 9)
+    vertices = [pt for child in h3.cell_to_children(cell, 13) for pt in h3.cell_to_boundary(child)]
+    for feature in (get_buffered_h3_polygon(cell), get_buffered_boundary_polygon(cell, 11)):
+        polygon = shape(feature["geometry"])
+        assert all(polygon.covers(Point(lng, lat)) for lat, lng in vertices)
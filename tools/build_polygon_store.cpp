@@ -0,0 +1,145 @@
+// Generates a polygon store (see h3_toolkit::PolygonStore) for every cell of
+// a resolution. Interrupted runs resume from the checkpoint next to the output.
+//
+//   build_polygon_store OUTPUT [--function buffered|boundary] [--res N]
+//                       [--target-res N] [--buffer METERS] [--accurate]
+//                       [--projection degrees|aeqd] [--threads N]
+//                       [--chunk-size N] [--checkpoint PATH]
+#include "h3_toolkit.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: build_polygon_store OUTPUT [--function buffered|boundary] [--res N]\n"
+                 "                           [--target-res N] [--buffer METERS] [--accurate]\n"
+                 "                           [--projection degrees|aeqd] [--threads N]\n"
+                 "                           [--chunk-size N] [--checkpoint PATH]\n"
+                 "\n"
+                 "  --function    buffered: get_buffered_boundary_polygon (default)\n"
+                 "                boundary: cell_boundary_from_children\n"
+                 "  --res         resolution of the stored cells (default 6)\n"
+                 "  --target-res  intermediate_res / target_res (default 10)\n"
+                 "  --buffer      buffer in meters, negative = auto (default -1)\n"
+                 "  --accurate    exact outline instead of the convex hull (buffered only)\n"
+                 "  --projection  degrees: buffer in lon/lat (default)\n"
+                 "                aeqd: buffer in a local azimuthal equidistant projection\n"
+                 "  --threads     threads to use, 0 = all (default 0)\n"
+                 "  --chunk-size  cells computed between checkpoints (default 4096)\n"
+                 "  --checkpoint  checkpoint path (default OUTPUT.partial)\n";
+}
+
+/** The whole of text as a number, or std::invalid_argument naming the option. */
+template <typename T, typename Parse>
+T parse_number(const std::string& option, const std::string& text, Parse parse) {
+    size_t used = 0;
+    T number{};
+    try {
+        number = parse(text, &used);
+    } catch (const std::logic_error&) {
+        used = 0;
+    }
+    if (text.empty() || used != text.size()) {
+        throw std::invalid_argument("invalid value for " + option + ": '" + text + "'");
+    }
+    return number;
+}
+
+int parse_int(const std::string& option, const std::string& text) {
+    return parse_number<int>(option, text, [](const std::string& t, size_t* used) { return std::stoi(t, used); });
+}
+
+double parse_double(const std::string& option, const std::string& text) {
+    return parse_number<double>(option, text, [](const std::string& t, size_t* used) { return std::stod(t, used); });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        usage();
+        return 2;
+    }
+    std::string output = argv[1];
+    h3_toolkit::PolygonStoreSpec spec;
+    h3_toolkit::PolygonStoreBuildOptions options;
+
+    try {
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    usage();
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+            if (arg == "--function") {
+                std::string function = value();
+                if (function == "buffered") {
+                    spec.function = h3_toolkit::StoredPolygon::BufferedBoundary;
+                } else if (function == "boundary") {
+                    spec.function = h3_toolkit::StoredPolygon::BoundaryFromChildren;
+                } else {
+                    usage();
+                    return 2;
+                }
+            } else if (arg == "--res") {
+                spec.cell_res = parse_int(arg, value());
+            } else if (arg == "--target-res") {
+                spec.target_res = parse_int(arg, value());
+            } else if (arg == "--buffer") {
+                spec.buffer_meters = parse_double(arg, value());
+            } else if (arg == "--accurate") {
+                spec.use_convex_hull = false;
+            } else if (arg == "--projection") {
+                std::string projection = value();
+                if (projection == "degrees") {
+                    spec.projection = h3_toolkit::BufferProjection::Degrees;
+                } else if (projection == "aeqd") {
+                    spec.projection = h3_toolkit::BufferProjection::LocalAzimuthalEquidistant;
+                } else {
+                    usage();
+                    return 2;
+                }
+            } else if (arg == "--threads") {
+                options.num_threads = parse_int(arg, value());
+            } else if (arg == "--chunk-size") {
+                int chunk_size = parse_int(arg, value());
+                if (chunk_size <= 0) {
+                    throw std::invalid_argument("--chunk-size must be positive");
+                }
+                options.chunk_size = static_cast<size_t>(chunk_size);
+            } else if (arg == "--checkpoint") {
+                options.checkpoint_path = value();
+            } else {
+                usage();
+                return 2;
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "build_polygon_store: " << e.what() << "\n\n";
+        usage();
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    options.progress = [&](size_t done, size_t total) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "\r" << done << " / " << total << " cells (" << static_cast<int>(seconds) << " s)" << std::flush;
+    };
+
+    try {
+        h3_toolkit::build_polygon_store(output, spec, options);
+    } catch (const std::exception& e) {
+        std::cerr << "\nbuild_polygon_store: " << e.what() << std::endl;
+        return 1;
+    }
+    h3_toolkit::PolygonStore store(output);
+    std::cerr << "\nwrote " << store.size() << " polygons to " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+// Generates src/cpp/src/overhang_table.hpp: the largest distance by which
+// descendants at one resolution stick out of their ancestor's cell, for
+// every (resolution, descendant resolution) pair, hexagons and pentagons.
+//
+//   generate_overhang_table [--safety FACTOR] > src/cpp/src/overhang_table.hpp
+//   generate_overhang_table --python [--safety FACTOR] > src/python/h3_toolkit/_overhang_table.py
+//
+// The Python table is what the pure-Python backend buffers by, so the two
+// must be regenerated together.
+//
+// H3 lays out each icosahedron face as a planar aperture-7 hexagon grid in
+// a gnomonic projection about the face center. In that plane every cell is a
+// regular hexagon and its seven children are the same hexagon scaled by
+// 1/sqrt(7) and rotated by +-19.1 degrees (alternating with the resolution
+// class), so the overhang of depth-k descendants is c_k times the ancestor's
+// edge length for one constant c_k per depth. The rotations alternate in sign
+// and the hexagon is mirror-symmetric, so c_k does not depend on the class.
+//
+// c_k is found by branch and bound over the descendant tree. A cell at depth
+// j cannot hold a depth-k point further out than its own furthest vertex
+// plus c_(k-j) of its edge, and c_(k-j) is already known exactly. The search
+// grows about 6x per level, so beyond depth 8 the same argument bounds it:
+// c_k <= c_8 + c_(k-8) / sqrt(7)^8, within 1e-4 of the limit (c_8 = 0.1443).
+//
+// The inverse gnomonic projection shortens every distance: by cos(theta)
+// or more at an angle theta from the face center, and not at all at the
+// center, where the cells are largest. So on the sphere the overhang is at
+// most c_k times the planar edge length in meters at the face center. Pentagons
+// sit on icosahedron vertices, 37.38 degrees from every face center, and get
+// the cos(theta) credit for the closest their descendants come to a center.
+// Cells folded across icosahedron edges are not covered by the argument. The
+// safety factor (default 1.1) is there for them.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int kMaxRes = 15;
+constexpr int kExactDepth = 8;
+constexpr double kEarthRadiusM = 6371007.180918475;
+// h3lib: res 0 distance between adjacent cell centers, in gnomonic units
+constexpr double kRes0CenterSpacing = 0.38196601125010500003;
+// h3lib: angle between an icosahedron face center and its vertices
+constexpr double kFaceCenterToVertexRads = 0.652358139784368185995;
+// h3lib M_AP7_ROT_RADS: rotation between consecutive resolutions' grids
+constexpr double kAp7Rotation = 0.333473172251832115336090755351601070065900389;
+
+const double kSqrt3 = std::sqrt(3.0);
+const double kSqrt7 = std::sqrt(7.0);
+
+/** A planar cell: center, distance between its lattice's centers, lattice angle. */
+struct Cell {
+    double x, y;
+    double spacing;
+    double angle;
+};
+
+/** Vertex m (0-5) of a cell: its corners sit 30 degrees off the lattice directions. */
+void vertex(const Cell& cell, int m, double& x, double& y) {
+    double a = cell.angle + M_PI / 6 + m * M_PI / 3;
+    x = cell.x + cell.spacing / kSqrt3 * std::cos(a);
+    y = cell.y + cell.spacing / kSqrt3 * std::sin(a);
+}
+
+/** The seven children; 'sign' picks the rotation direction of this level. */
+void children(const Cell& cell, int sign, Cell out[7]) {
+    double spacing = cell.spacing / kSqrt7;
+    double angle = cell.angle + sign * kAp7Rotation;
+    out[0] = {cell.x, cell.y, spacing, angle};
+    for (int m = 0; m < 6; ++m) {
+        double a = angle + m * M_PI / 3;
+        out[m + 1] = {cell.x + spacing * std::cos(a), cell.y + spacing * std::sin(a), spacing, angle};
+    }
+}
+
+/** The depth-0 cell: centered at the origin with unit center spacing. */
+const Cell kRoot = {0, 0, 1, 0};
+double root_x[7], root_y[7];
+
+/** Distance from (x, y) to the root hexagon, 0 inside it. */
+double distance_outside(double x, double y) {
+    bool inside = true;
+    double best = 1e300;
+    for (int m = 0; m < 6; ++m) {
+        double ax = root_x[m], ay = root_y[m];
+        double ex = root_x[m + 1] - ax, ey = root_y[m + 1] - ay;
+        // Counter-clockwise ring: outside is to the right of some edge
+        if (ex * (y - ay) - ey * (x - ax) < 0) {
+            inside = false;
+        }
+        double t = std::max(0.0, std::min(1.0, ((x - ax) * ex + (y - ay) * ey) / (ex * ex + ey * ey)));
+        best = std::min(best, std::hypot(x - ax - t * ex, y - ay - t * ey));
+    }
+    return inside ? 0.0 : best;
+}
+
+double furthest_vertex(const Cell& cell) {
+    double best = 0;
+    for (int m = 0; m < 6; ++m) {
+        double x, y;
+        vertex(cell, m, x, y);
+        best = std::max(best, distance_outside(x, y));
+    }
+    return best;
+}
+
+/**
+ * Branch and bound for the overhang of depth-'depth' descendants; 'known'
+ * holds c_1 .. c_(depth-1).
+ */
+void search(const Cell& cell, int level, int depth, const std::vector<double>& known, double& best) {
+    double edge = cell.spacing / kSqrt3;
+    double here = furthest_vertex(cell);
+    if (level == depth) {
+        best = std::max(best, here);
+        return;
+    }
+    // Below the root, every depth-'depth' point lies within c_(depth-level)
+    // of this cell's edge length of the cell
+    if (level > 0 && here + known[depth - level] * edge / (kRoot.spacing / kSqrt3) <= best) {
+        return;
+    }
+    Cell next[7];
+    children(cell, level % 2 ? -1 : 1, next);
+    for (const Cell& child : next) {
+        search(child, level + 1, depth, known, best);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double safety = 1.1;
+    bool python = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--safety") == 0 && i + 1 < argc) {
+            safety = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--python") == 0) {
+            python = true;
+        } else {
+            std::fprintf(stderr, "usage: generate_overhang_table [--python] [--safety FACTOR] > TABLE\n");
+            return 2;
+        }
+    }
+
+    for (int m = 0; m <= 6; ++m) {
+        vertex(kRoot, m % 6, root_x[m], root_y[m]);
+    }
+    // c[k]: overhang of depth-k descendants in edge lengths of the ancestor
+    double root_edge = kRoot.spacing / kSqrt3;
+    std::vector<double> c(kMaxRes + 1, 0.0);
+    for (int depth = 1; depth <= kMaxRes; ++depth) {
+        if (depth > kExactDepth) {
+            c[depth] = c[kExactDepth] + c[depth - kExactDepth] / std::pow(kSqrt7, kExactDepth);
+            continue;
+        }
+        double best = 0;
+        search(kRoot, 0, depth, c, best);
+        c[depth] = best / root_edge;
+    }
+
+    // meters[pentagon][res][d]
+    double meters[2][kMaxRes + 1][kMaxRes + 1];
+    for (int pentagon = 0; pentagon < 2; ++pentagon) {
+        for (int res = 0; res <= kMaxRes; ++res) {
+            double edge = kRes0CenterSpacing / std::pow(kSqrt7, res) / kSqrt3;
+            double scale = 1.0;
+            if (pentagon) {
+                // Closest approach to a face center: the pentagon's radius plus its overhang
+                scale = std::cos(std::max(0.0, kFaceCenterToVertexRads - edge * (1 + c[kMaxRes])));
+            }
+            for (int d = 0; d <= kMaxRes; ++d) {
+                meters[pentagon][res][d] = d > res ? safety * scale * c[d - res] * edge * kEarthRadiusM : 0.0;
+            }
+        }
+    }
+
+    if (python) {
+        std::printf("\"\"\"\n"
+                    "Generated by tools/generate_overhang_table.cpp --python (safety factor %.2f). Do not edit.\n"
+                    "\n"
+                    "DESCENDANT_OVERHANG_M[pentagon][res][descendant_res]: the same table as\n"
+                    "src/cpp/src/overhang_table.hpp, for the pure-Python backend.\n"
+                    "\"\"\"\n\n"
+                    "DESCENDANT_OVERHANG_M = (\n",
+                    safety);
+        for (int pentagon = 0; pentagon < 2; ++pentagon) {
+            std::printf("    (  # %s\n", pentagon ? "Pentagons" : "Hexagons");
+            for (int res = 0; res <= kMaxRes; ++res) {
+                std::printf("        (");
+                for (int d = 0; d <= kMaxRes; ++d) {
+                    std::printf("%s%.6g", d ? ", " : "", meters[pentagon][res][d]);
+                }
+                std::printf("),  # res %d\n", res);
+            }
+            std::printf("    ),\n");
+        }
+        std::printf(")\n");
+        return 0;
+    }
+
+    std::printf("/**\n"
+                " * @file overhang_table.hpp\n"
+                " * @brief Generated by tools/generate_overhang_table.cpp (safety factor %.2f). Do not edit.\n"
+                " *\n"
+                " * kDescendantOverhangM[pentagon][res][descendant_res]: the furthest, in meters,\n"
+                " * that any descendant at descendant_res reaches outside its ancestor at res;\n"
+                " * zero unless descendant_res > res. See the generator for the derivation.\n"
+                " */\n\n"
+                "#pragma once\n\n"
+                "namespace h3_toolkit {\n"
+                "namespace detail {\n\n"
+                "// Planar overhang in ancestor edge lengths, by depth:",
+                safety);
+    for (int k = 1; k <= kMaxRes; ++k) {
+        std::printf("%s%.4f", k % 8 == 1 ? "\n//  " : " ", c[k]);
+    }
+    std::printf("\nconstexpr double kDescendantOverhangM[2][%d][%d] = {\n", kMaxRes + 1, kMaxRes + 1);
+    for (int pentagon = 0; pentagon < 2; ++pentagon) {
+        std::printf("    {   // %s\n", pentagon ? "Pentagons" : "Hexagons");
+        for (int res = 0; res <= kMaxRes; ++res) {
+            std::printf("        {");
+            for (int d = 0; d <= kMaxRes; ++d) {
+                std::printf("%s%.6g", d ? ", " : "", meters[pentagon][res][d]);
+            }
+            std::printf("},  // res %d\n", res);
+        }
+        std::printf("    },\n");
+    }
+    std::printf("};\n\n"
+                "} // namespace detail\n"
+                "} // namespace h3_toolkit\n");
+    return 0;
+}